@@ -0,0 +1,366 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2018 Liberty Global B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* gdbus-client-bench measures the throughput and the latency of the client against an
+ * echo service, on a private bus started with GTestDBus (dbus-daemon has to be in PATH).
+ * The private bus stands in for the system bus, so nothing on the box is disturbed.
+ *
+ * Each result is printed as one JSON object per line, to be collected and compared
+ * between the builds:
+ *
+ *      gdbus-client-bench [iterations]     # 2000 calls per thread and case by default
+ */
+
+#include "GDBusClient.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gio/gio.h>
+
+using namespace gdbus_client;
+
+namespace {
+
+    const char *SERVICE = "com.lgi.rdk.GDBusClientBench";       // the path and the interface follow the name
+    const char *SERVICE_PATH = "/com/lgi/rdk/GDBusClientBench";
+
+    const char *SERVICE_XML =
+            "<node>"
+            "  <interface name='com.lgi.rdk.GDBusClientBench'>"
+            "    <method name='Ping'/>"
+            "    <method name='EchoAs'>"
+            "      <arg type='as' direction='in'/><arg type='as' direction='out'/>"
+            "    </method>"
+            "    <method name='EchoDict'>"
+            "      <arg type='a{ss}' direction='in'/><arg type='a{ss}' direction='out'/>"
+            "    </method>"
+            "    <method name='Tuples'>"
+            "      <arg type='u' direction='in'/><arg type='a(sid)' direction='out'/>"
+            "    </method>"
+            "    <method name='Emit'>"
+            "      <arg type='u' direction='in'/>"
+            "    </method>"
+            "    <signal name='Tick'><arg type='u'/></signal>"
+            "  </interface>"
+            "</node>";
+
+
+    // The calls and the signal under test
+
+    struct Ping: GDBusCall {
+        Ping(): GDBusCall(SERVICE, "Ping") {}
+    };
+
+    struct EchoAs: GDBusCall {
+        EchoAs(): GDBusCall(SERVICE, "EchoAs") {}
+        GDBusParam<TYPE_AS,     PARAM_IN,   str_arr_t>      in          {"in"};
+        GDBusParam<TYPE_AS,     PARAM_OUT,  str_arr_t>      out         {"out"};
+    };
+
+    struct EchoDict: GDBusCall {
+        EchoDict(): GDBusCall(SERVICE, "EchoDict") {}
+        GDBusParam<TYPE_DICT,   PARAM_IN,   dict_t>         in          {"in"};
+        GDBusParam<TYPE_DICT,   PARAM_OUT,  dict_t>         out         {"out"};
+    };
+
+    struct Tuples: GDBusCall {
+        Tuples(): GDBusCall(SERVICE, "Tuples") {}
+        GDBusParam<TYPE_U,      PARAM_IN,   unsigned>       count       {"count"};
+        GDBusParam<TYPE_ATUP,   PARAM_OUT,  tuple_arr_t>    tuples      {"tuples"};
+    };
+
+    struct Emit: GDBusCall {
+        Emit(): GDBusCall(SERVICE, "Emit") {}
+        GDBusParam<TYPE_U,      PARAM_IN,   unsigned>       count       {"count"};
+    };
+
+    struct Tick: GDBusSignal {
+        Tick(): GDBusSignal(SERVICE, "Tick") {}
+        GDBusParam<TYPE_U,      PARAM_OUT,  unsigned>       seq         {"seq"};
+    };
+
+
+    // The echo service runs in its own thread, on its own connection to the private bus
+    struct echo_service_t {
+        GMainContext *context = g_main_context_new();
+        GMainLoop *loop = g_main_loop_new(context, false);
+        GDBusConnection *connection = nullptr;
+        std::thread thread;
+
+        bool start(const char *address) {
+            std::mutex mutex;
+            std::unique_lock<std::mutex> lock{ mutex };
+            std::condition_variable started;
+            bool ok = false, done = false;
+
+            thread = std::thread{ [&]() {
+                g_main_context_push_thread_default(context);
+                {
+                    std::lock_guard<std::mutex> lock{ mutex };
+                    ok = registerOn(address);
+                    done = true;
+                }
+                started.notify_one();
+                if (ok)
+                    g_main_loop_run(loop);
+                g_main_context_pop_thread_default(context);
+            }};
+            started.wait(lock, [&done]{ return done; });
+            return ok;
+        }
+
+        void stop() {
+            g_main_loop_quit(loop);
+            if (thread.joinable())
+                thread.join();
+            g_clear_object(&connection);
+            g_main_loop_unref(loop);
+            g_main_context_unref(context);
+        }
+
+        bool registerOn(const char *address) {
+            GError *err = nullptr;
+            connection = g_dbus_connection_new_for_address_sync(address,
+                    static_cast<GDBusConnectionFlags>(G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT |
+                                                      G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION),
+                    nullptr, nullptr, &err);
+            GDBusNodeInfo *node = connection ? g_dbus_node_info_new_for_xml(SERVICE_XML, &err) : nullptr;
+            static const GDBusInterfaceVTable vtable = { onMethodCall, nullptr, nullptr, {} };
+            const unsigned id = node ?
+                    g_dbus_connection_register_object(connection, SERVICE_PATH, node->interfaces[0],
+                                                      &vtable, this, nullptr, &err) :
+                    0;
+            if (node)
+                g_dbus_node_info_unref(node);
+            GVariant *reply = id ?
+                    g_dbus_connection_call_sync(connection, "org.freedesktop.DBus", "/org/freedesktop/DBus",
+                                                "org.freedesktop.DBus", "RequestName",
+                                                g_variant_new("(su)", SERVICE, 0u), nullptr,
+                                                G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &err) :
+                    nullptr;
+            if (reply)
+                g_variant_unref(reply);
+            if (err) {
+                std::fprintf(stderr, "echo service: %s\n", err->message);
+                g_error_free(err);
+            }
+            return reply != nullptr;
+        }
+
+        static void onMethodCall(GDBusConnection *connection, const char *, const char *, const char *,
+                                 const char *method, GVariant *parameters,
+                                 GDBusMethodInvocation *invocation, void *)
+        {
+            const std::string name{ method };
+            if (name == "Ping") {
+                g_dbus_method_invocation_return_value(invocation, nullptr);
+            }
+            else if (name == "EchoAs" || name == "EchoDict") {
+                g_dbus_method_invocation_return_value(invocation, parameters);
+            }
+            else if (name == "Tuples") {
+                unsigned count = 0;
+                g_variant_get(parameters, "(u)", &count);
+                GVariantBuilder *builder = g_variant_builder_new(G_VARIANT_TYPE("a(sid)"));
+                for (unsigned i = 0; i < count; i++)
+                    g_variant_builder_add(builder, "(sid)", "channel", static_cast<int>(i), i * 0.5);
+                g_dbus_method_invocation_return_value(invocation, g_variant_new("(a(sid))", builder));
+                g_variant_builder_unref(builder);
+            }
+            else if (name == "Emit") {
+                unsigned count = 0;
+                g_variant_get(parameters, "(u)", &count);
+                g_dbus_method_invocation_return_value(invocation, nullptr);
+                for (unsigned i = 0; i < count; i++)
+                    g_dbus_connection_emit_signal(connection, nullptr, SERVICE_PATH, SERVICE, "Tick",
+                                                  g_variant_new("(u)", i), nullptr);
+            }
+        }
+    };
+
+
+    // Reporting
+
+    struct latencies_t {
+        std::vector<double> us;
+
+        double percentile(double p) {
+            if (us.empty())
+                return 0;
+            std::sort(us.begin(), us.end());
+            return us[static_cast<size_t>(p * (us.size() - 1))];
+        }
+    };
+
+    void report(const char *bench, const std::string &args, size_t count, double seconds, latencies_t &lat) {
+        std::printf("{\"bench\": \"%s\", %s, \"count\": %zu, \"per_second\": %.1f, "
+                    "\"p50_us\": %.1f, \"p99_us\": %.1f}\n",
+                    bench, args.c_str(), count, seconds > 0 ? count / seconds : 0.0,
+                    lat.percentile(0.5), lat.percentile(0.99));
+        std::fflush(stdout);
+    }
+
+
+    // Make 'iterations' invocations of 'call' in each of 'threads' threads. 'call' gets
+    // the instance the thread should use: its own one, or one shared by all the threads
+    // and serialized with a mutex.
+    template<typename C, typename Prepare>
+    void benchCalls(const char *bench, const std::string &args, unsigned threads, bool shared,
+                    unsigned iterations, Prepare prepare)
+    {
+        using clock = std::chrono::steady_clock;
+        C shared_call;
+        prepare(shared_call);
+        std::mutex shared_mutex;
+        std::atomic<unsigned> failures{ 0 };
+        std::vector<latencies_t> lat(threads);
+
+        const auto start = clock::now();
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back([&, t]() {
+                thread_local C own_call;
+                prepare(own_call);
+                lat[t].us.reserve(iterations);
+                for (unsigned i = 0; i < iterations; i++) {
+                    const auto before = clock::now();
+                    bool ok;
+                    if (shared) {
+                        std::lock_guard<std::mutex> lock{ shared_mutex };
+                        ok = shared_call.callSync();
+                    }
+                    else {
+                        ok = own_call.callSync();
+                    }
+                    lat[t].us.push_back(std::chrono::duration<double, std::micro>(clock::now() - before).count());
+                    if (!ok)
+                        failures++;
+                }
+            });
+        }
+        for (auto &w: workers)
+            w.join();
+        const double seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+        latencies_t all;
+        for (auto &l: lat)
+            all.us.insert(all.us.end(), l.us.begin(), l.us.end());
+        report(bench, args + ", \"threads\": " + std::to_string(threads) +
+                      ", \"instance\": \"" + (shared ? "shared" : "thread_local") + "\"" +
+                      ", \"failures\": " + std::to_string(failures.load()),
+               all.us.size(), seconds, all);
+    }
+
+    // Emit 'count' signals, received by 'subscribers' instances of Tick in the signal loop
+    void benchSignals(unsigned subscribers, unsigned count) {
+        using clock = std::chrono::steady_clock;
+        std::vector<std::unique_ptr<Tick>> ticks;
+        std::atomic<unsigned> received{ 0 };
+        for (unsigned i = 0; i < subscribers; i++) {
+            ticks.emplace_back(new Tick);
+            ticks.back()->subscribe([&received]{ received++; });
+        }
+
+        std::atomic<bool> running{ true };
+        std::thread loop{ [&running]{ while (running && waitAndProcessSignals(100)) {} } };
+
+        Emit emit;
+        emit.count.value = count;
+        const auto start = clock::now();
+        const auto expected = count * subscribers;
+        const bool ok = emit.callSync();
+        while (ok && received < expected && clock::now() - start < std::chrono::seconds{ 30 })
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+        const double seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+        running = false;
+        loop.join();
+        ticks.clear();          // not destroyed while the loop runs, see GDBusSignal::subscribe
+
+        latencies_t none;
+        report("signal_fanout", "\"subscribers\": " + std::to_string(subscribers) +
+                                ", \"delivered\": " + std::to_string(received.load()),
+               received.load(), seconds, none);
+    }
+
+    str_arr_t strings(unsigned n) {
+        str_arr_t arr;
+        for (unsigned i = 0; i < n; i++)
+            arr.push_back("item-" + std::to_string(i));
+        return arr;
+    }
+
+    dict_t dict(unsigned n) {
+        dict_t d;
+        for (unsigned i = 0; i < n; i++)
+            d["key-" + std::to_string(i)] = "value-" + std::to_string(i);
+        return d;
+    }
+}
+
+
+int main(int argc, char *argv[]) {
+    const unsigned iterations = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 2000;
+
+    GTestDBus *bus = g_test_dbus_new(G_TEST_DBUS_NONE);
+    g_test_dbus_up(bus);
+    const char *address = g_test_dbus_get_bus_address(bus);
+    if (!address) {
+        std::fprintf(stderr, "cannot start the private bus; is dbus-daemon installed?\n");
+        return 1;
+    }
+    g_setenv("DBUS_SYSTEM_BUS_ADDRESS", address, true);    // the client talks to the system bus only
+
+    echo_service_t service;
+    if (!service.start(address))
+        return 1;
+
+    const auto nothing = [](GDBusCall &) {};
+    for (unsigned threads: { 1, 2, 4, 8 }) {
+        benchCalls<Ping>("ping", "\"payload\": 0", threads, false, iterations, nothing);
+        benchCalls<Ping>("ping", "\"payload\": 0", threads, true, iterations, nothing);
+    }
+    for (unsigned payload: { 1, 64, 1024 }) {
+        const std::string args = "\"payload\": " + std::to_string(payload);
+        benchCalls<EchoAs>("echo_as", args, 1, false, iterations,
+                           [payload](EchoAs &c) { c.in.value = strings(payload); });
+        benchCalls<EchoDict>("echo_dict", args, 1, false, iterations,
+                             [payload](EchoDict &c) { c.in.value = dict(payload); });
+        benchCalls<Tuples>("tuples", args, 1, false, iterations,
+                           [payload](Tuples &c) { c.count.value = payload; });
+    }
+    for (unsigned subscribers: { 1, 8, 64 }) {
+        benchSignals(subscribers, iterations);
+    }
+
+    service.stop();
+    stopProcessingSignals();
+    g_test_dbus_down(bus);
+    g_object_unref(bus);
+    return 0;
+}
@@ -21,19 +21,27 @@
 #include <cstdint>
 #include <cstdlib>
 #include <cstdio> //for logging backup if rdk logger fails to initialize
+#include <cstring>
 #include <vector>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <string>
 #include <functional>
 #include <utility>
+#include <tuple>
 #include <algorithm>
-#include <regex>
+#include <memory>
 #include <mutex>
 #include <atomic>
 #include <thread>
+#include <condition_variable>
 #include <chrono>
+#include <random>
 #include <gio/gio.h>
+#include <gio/gunixfdlist.h>
+#include <poll.h>
+#include <unistd.h>
 
 #define AT() __func__, __LINE__
 
@@ -59,10 +67,17 @@ namespace gdbus_client {
         GVariant * marshal( TYPE_D,     double);
         GVariant * marshal( TYPE_O,     const std::string&);
         GVariant * marshal( TYPE_V,     const std::string&);
+        GVariant * marshal( TYPE_H,     int);
         GVariant * marshal( TYPE_AS,    const str_arr_t &);
         GVariant * marshal( TYPE_AO,    const str_arr_t &);
+        GVariant * marshal( TYPE_AY,    const byte_arr_t &);
+        GVariant * marshal( TYPE_AI,    const int_arr_t &);
+        GVariant * marshal( TYPE_AU,    const uint_arr_t &);
+        GVariant * marshal( TYPE_AT,    const uint64_arr_t &);
+        GVariant * marshal( TYPE_AD,    const double_arr_t &);
         GVariant * marshal( TYPE_DICT,  const dict_t&);
-        //GVariant * marshal( TYPE_DICT,  const dict_t&);       // Not implemented: not useful.
+        //GVariant * marshal( TYPE_VDICT, const dict_t&);       // Not implemented: the printed values cannot be parsed back
+        GVariant * marshal( TYPE_VDICT, const vdict_t&);
         //GVariant * marshal( TYPE_ATUP,  const tuple_arr_t &); // Not implemented: TYPE_ATUP is intended for out params only
         //GVariant * marshal( TYPE_ANY,   const std::string&);  // Not implemented: TYPE_ANY is intended for out params only
         bool unmarshal(     TYPE_S,     GVariant *, std::string&);
@@ -75,13 +90,39 @@ namespace gdbus_client {
         bool unmarshal(     TYPE_D,     GVariant *, double&);
         bool unmarshal(     TYPE_O,     GVariant *, std::string&);
         bool unmarshal(     TYPE_V,     GVariant *, std::string&);
+        bool unmarshal(     TYPE_H,     GVariant *, int&);
         bool unmarshal(     TYPE_AS,    GVariant *, str_arr_t&);
+        bool unmarshal(     TYPE_AS,    GVariant *, as_view_t&);
         bool unmarshal(     TYPE_AO,    GVariant *, str_arr_t&);
+        bool unmarshal(     TYPE_AO,    GVariant *, ao_view_t&);
+        bool unmarshal(     TYPE_AY,    GVariant *, byte_arr_t&);
+        bool unmarshal(     TYPE_AI,    GVariant *, int_arr_t&);
+        bool unmarshal(     TYPE_AU,    GVariant *, uint_arr_t&);
+        bool unmarshal(     TYPE_AT,    GVariant *, uint64_arr_t&);
+        bool unmarshal(     TYPE_AD,    GVariant *, double_arr_t&);
         bool unmarshal(     TYPE_DICT,  GVariant *, dict_t&);
+        bool unmarshal(     TYPE_DICT,  GVariant *, dict_view_t&);
         bool unmarshal(     TYPE_VDICT, GVariant *, dict_t&);
+        bool unmarshal(     TYPE_VDICT, GVariant *, vdict_t&);
         bool unmarshal(     TYPE_ATUP,  GVariant *, tuple_arr_t&);
         bool unmarshal(     TYPE_ANY,   GVariant *, std::string&);
+        GVariant * marshal( const GDBusStructParam&);               // TYPE_STRUCT<Row> and TYPE_ASTRUCT<Row>
+        bool unmarshal(     GDBusStructParam&, GVariant *);
+
+        // The fd lists of the message being marshalled and of the one being unmarshalled in
+        // this thread, used by the TYPE_H converters. The out list is created by the marshaller
+        // of the first fd; the message takes it over, see marshalInParams.
+        GUnixFDList*& outFdList();
+        GUnixFDList*& inFdList();
     }
+
+    // GDBusCallAccess gives access to the opaque state of GDBusCall and GDBusSignal instances.
+    struct GDBusCallAccess {
+        template<typename C>
+        static const std::shared_ptr<void>& state(const C &c) { return c.call; }
+        template<typename C>
+        static std::shared_ptr<void>& state(C &c) { return c.call; }
+    };
 }
 
 
@@ -90,28 +131,57 @@ namespace {
     struct call_t;
     struct param_t;
     struct proxy_t;
+    struct proxy_slot_t;
+    struct coalescer_t;
 
     struct obj_desc_t {                                     // D-Bus service descriptor
         std::string name, path, iface;
+        unsigned proxy_flags = 0;                           // GDBusObjectDescriptor::proxy_flags
 
         static obj_desc_t fromName(const std::string &name) {
-            const std::regex dot_regex{ "[.]" };            // the regex to convert obj_name to obj_path, '.' --> '/'
-            return obj_desc_t{
-                name,
-                std::string("/") + std::regex_replace(name, dot_regex, "/"),
-                name };
+            std::string path;                               // convert obj_name to obj_path, '.' --> '/', in one pass
+            path.reserve(name.size() + 1);
+            path += '/';
+            for (const char c: name)
+                path += (c == '.') ? '/' : c;
+            return obj_desc_t{ name, std::move(path), name };
         }
 
         static obj_desc_t fromDesc(const gdbus_client::GDBusObjectDescriptor &d)
         {
-            return obj_desc_t{ d.obj_name, d.obj_path, d.iface_name };
+            return obj_desc_t{ d.obj_name, d.obj_path, d.iface_name, d.proxy_flags };
+        }
+
+        bool operator<(const obj_desc_t &o) const {
+            return std::tie(name, path, iface, proxy_flags) < std::tie(o.name, o.path, o.iface, o.proxy_flags);
+        }
+    };
+
+
+    // interned_t is the shared table of the D-Bus targets and member names. Each distinct
+    // value is stored once, and never removed, so the call descriptions, the proxy slots,
+    // the metrics and the signal subscriptions refer to the same copy, and key their tables
+    // by its address. The lock is taken only when a description or a subscription is made.
+    struct interned_t {
+        static const obj_desc_t& object(const obj_desc_t &obj) {    // Reentrant
+            std::lock_guard<std::mutex> lock{ mutex() };
+            return *objects().insert(obj).first;
         }
+
+        static const std::string& name(const std::string &name) {   // Reentrant
+            std::lock_guard<std::mutex> lock{ mutex() };
+            return *names().insert(name).first;
+        }
+
+        static std::mutex& mutex() { static std::mutex m; return m; }
+        static std::set<obj_desc_t>& objects() { static std::set<obj_desc_t> o; return o; }
+        static std::set<std::string>& names() { static std::set<std::string> n; return n; }
     };
 
 
-    thread_local const gdbus_client::GDBusCall* callUnderConstruction = nullptr;// Set in GDBusCall ctor and cleared in GDBusCall dtor.
-                                                                                // Thread-local to avoid bogus interaction when initializing
-                                                                                //      GDBusCall-s in different threads at the same time.
+    thread_local call_t* callUnderConstruction = nullptr;       // Set in GDBusCall (or GDBusSignal) ctor and cleared in its dtor.
+                                                                // Thread-local to avoid bogus interaction when initializing
+                                                                //      GDBusCall-s in different threads at the same time.
     bool logAssert( const char *func, unsigned line,
                     bool f, const std::string &err);
 
@@ -138,12 +208,16 @@ namespace {
             SERVICE_UNKNOWN,
             SERVER_DISCONNECT,
             ACCESS_DENIED,
+            TIMEOUT,
             UNSPECIFIED };
 
         const std::map<std::pair<unsigned,int>, errcode_t> errorMap {
             {{G_DBUS_ERROR, G_DBUS_ERROR_SERVICE_UNKNOWN},  SERVICE_UNKNOWN},
             {{G_DBUS_ERROR, G_DBUS_ERROR_DISCONNECTED},     SERVER_DISCONNECT},
             {{G_DBUS_ERROR, G_DBUS_ERROR_ACCESS_DENIED},    ACCESS_DENIED},
+            {{G_DBUS_ERROR, G_DBUS_ERROR_TIMEOUT},          TIMEOUT},
+            {{G_DBUS_ERROR, G_DBUS_ERROR_NO_REPLY},         TIMEOUT},
+            {{G_IO_ERROR,   G_IO_ERROR_TIMED_OUT},          TIMEOUT},
         };
 
         errcode_t errType() const {
@@ -158,118 +232,933 @@ namespace {
     };
 
 
-    struct call_t {
-        std::vector<param_t> params;                // in and out parameters that belong to this call
-        obj_desc_t object;                          // target of the call
-        std::string method;                         // the target method
+    // g_context_switcher allows to temporary change the GLib default thread context
+    struct gcontext_switcher_t {
+        GMainContext *context = nullptr;
+        gcontext_switcher_t(const gcontext_switcher_t &) = delete;
+        gcontext_switcher_t();  // the constructor changes the current gcontext to the one (indirectly) returned from mainLoopInstance
+        explicit gcontext_switcher_t(GMainContext *ctx);   // the same, but changes the current gcontext to the given one
+        ~gcontext_switcher_t(); // the destructor restores the current gcontext, if changed in constructor
+    };
 
-        call_t() = default;
-        call_t(call_t&&) = default;                 // Allow move ctor and forbid copy ctor implicitly
 
-        call_t(obj_desc_t obj, std::string method)
-            :   object{ std::move(obj) }, method{ std::move(method) }
-        {
-            verboseCheckNoErr(AT());
+    // connection_pool_t is the optional pool of private connections to the system bus, see
+    // GDBusCall::setConnectionPool. Connection 0 is the system bus connection GLib shares
+    // with the rest of the process; the private connections 1..size are opened on first
+    // use, and reopened if closed. Each thread is assigned one of them, round-robin.
+    struct connection_pool_t {
+        std::atomic<unsigned> size{ 0 };            // the number of private connections; 0 if the pool is disabled
+        std::atomic<unsigned> next{ 0 };            // the next connection to assign to a thread
+        std::mutex mutex;                           // protects 'connections'
+        std::map<unsigned, GDBusConnection*> connections;
+
+        // The connection of the calling thread; 0 if the pool is disabled
+        unsigned connectionOfThisThread() {
+            const unsigned n = size.load();
+            thread_local unsigned assigned = 0;
+            if (n != 0 && (assigned == 0 || assigned > n))
+                assigned = next++ % n + 1;
+            return n != 0 ? assigned : 0;
         }
 
-        bool verboseCheckNoErr(const char *func, unsigned line);
+        // Return a new reference to the private connection if it is open, or null
+        GDBusConnection* opened(unsigned index) {
+            std::lock_guard<std::mutex> lock{ mutex };
+            const auto found = connections.find(index);
+            if (found == connections.end() || g_dbus_connection_is_closed(found->second))
+                return nullptr;
+            return static_cast<GDBusConnection*>(g_object_ref(found->second));
+        }
+
+        // Return a new reference to the private connection, or null with err set if it cannot
+        // be opened. The connection is opened without the pool lock: only the calling thread
+        // waits for it.
+        GDBusConnection* connection(unsigned index, gerror_t &err) {
+            if (GDBusConnection *conn = opened(index))
+                return conn;
+            gchar *address = inPool(index, err) ?
+                    g_dbus_address_get_for_bus_sync(G_BUS_TYPE_SYSTEM, nullptr, static_cast<GError**>(err)) : nullptr;
+            GDBusConnection *conn = address ?
+                    g_dbus_connection_new_for_address_sync(address, FLAGS, nullptr, nullptr, static_cast<GError**>(err)) :
+                    nullptr;
+            g_free(address);
+            return conn ? publish(index, conn, err) : nullptr;
+        }
+
+        // The same as connection, without blocking: 'done' receives the connection (borrowed),
+        // or null, in the thread-default context of the caller.
+        using opened_t = std::function<void(GDBusConnection *conn)>;
+        void connectionAsync(unsigned index, opened_t done) {
+            if (GDBusConnection *conn = opened(index)) {
+                done(conn);
+                g_object_unref(conn);
+                return;
+            }
+            gerror_t err;
+            gchar *address = inPool(index, err) ?
+                    g_dbus_address_get_for_bus_sync(G_BUS_TYPE_SYSTEM, nullptr, static_cast<GError**>(err)) : nullptr;
+            if (!address) {
+                err.verboseCheckNoErr(AT());
+                done(nullptr);
+                return;
+            }
+            g_dbus_connection_new_for_address(address, FLAGS, nullptr, nullptr, onOpened,
+                                              new opening_t{ this, index, std::move(done) });
+            g_free(address);
+        }
+
+        // Set the number of the connections; close the ones beyond it
+        void resize(unsigned n) {
+            std::vector<GDBusConnection*> dropped;
+            {
+                std::lock_guard<std::mutex> lock{ mutex };
+                size.store(n);
+                for (auto i = connections.upper_bound(n); i != connections.end(); i = connections.erase(i))
+                    dropped.push_back(i->second);
+            }
+            for (GDBusConnection *conn: dropped) {  // the calls in flight on them fail, or are retried by their policy
+                g_dbus_connection_close(conn, nullptr, nullptr, nullptr);
+                g_object_unref(conn);
+            }
+        }
+
+    private:
+        static constexpr GDBusConnectionFlags FLAGS = static_cast<GDBusConnectionFlags>(
+                G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT | G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION);
+
+        struct opening_t {
+            connection_pool_t *pool;
+            unsigned index;
+            opened_t done;
+        };
+
+        static void onOpened(GObject *, GAsyncResult *res, void *data) {
+            std::unique_ptr<opening_t> opening{ static_cast<opening_t*>(data) };
+            gerror_t err;
+            GDBusConnection *conn = g_dbus_connection_new_for_address_finish(res, static_cast<GError**>(err));
+            if (conn)
+                conn = opening->pool->publish(opening->index, conn, err);
+            err.verboseCheckNoErr(AT());
+            opening->done(conn);
+            if (conn)
+                g_object_unref(conn);
+        }
+
+        bool inPool(unsigned index, gerror_t &err) const {    // the pool might shrink meanwhile
+            if (index != 0 && index <= size.load())
+                return true;
+            g_set_error_literal(static_cast<GError**>(err), G_IO_ERROR, G_IO_ERROR_CLOSED,
+                                "the connection is no longer in the pool");
+            return false;
+        }
+
+        // Store the connection just opened, unless another thread has opened it meanwhile, or
+        // the pool no longer has it. Takes over 'conn'; returns a new reference to the one kept.
+        GDBusConnection* publish(unsigned index, GDBusConnection *conn, gerror_t &err) {
+            GDBusConnection *kept = nullptr, *surplus = conn;
+            {
+                std::lock_guard<std::mutex> lock{ mutex };
+                if (inPool(index, err)) {
+                    GDBusConnection *&stored = connections[index];
+                    if (!stored || g_dbus_connection_is_closed(stored)) {
+                        std::swap(stored, surplus);             // drop the closed one, if any
+                    }
+                    kept = static_cast<GDBusConnection*>(g_object_ref(stored));
+                }
+            }
+            if (surplus) {
+                if (surplus == conn)
+                    g_dbus_connection_close(surplus, nullptr, nullptr, nullptr);
+                g_object_unref(surplus);
+            }
+            return kept;
+        }
+    }
+    connection_pool;
+
+
+    struct proxy_t {
+        GDBusProxy *proxy = nullptr;
+        std::string obj_name;
+
+        proxy_t(const proxy_t&) = delete;
+
+        // Create the proxy on the given connection of connection_pool_t
+        proxy_t(const obj_desc_t &obj, unsigned connection) : obj_name(obj.name) {
+            gcontext_switcher_t gcontext_switcher{}; // Push the thread-default context to make sure that
+                                                     //     the callbacks of the proxy are dispatched in the
+                                                     //     thread that runs waitAndProcessSignals (see).
+                                                     // Also creates the custom main loop and context if they are not yet created.
+            gerror_t err;
+            const GDBusProxyFlags flags = flagsOf(obj);
+            if (connection == 0) {
+                proxy = g_dbus_proxy_new_for_bus_sync(                   // The proxy is created in the new thread-default context,
+                    G_BUS_TYPE_SYSTEM, flags, nullptr,                   //    so its callbacks are dispatched in the context set by
+                    obj.name.c_str(), obj.path.c_str(), obj.iface.c_str(),//   the context switcher, which is the one bound to the main loop
+                    nullptr, static_cast<GError**>(err));                //    created in mainLoopInstance.
+            }
+            else if (GDBusConnection *conn = connection_pool.connection(connection, err)) {
+                proxy = g_dbus_proxy_new_sync(
+                    conn, flags, nullptr,
+                    obj.name.c_str(), obj.path.c_str(), obj.iface.c_str(),
+                    nullptr, static_cast<GError**>(err));
+                g_object_unref(conn);                           // the proxy keeps its own reference
+            }
+            err.verboseCheckNoErr(AT());
+            if (proxy)
+                alive()++;
+        }
+
+        // Adopt the proxy created asynchronously, see proxy_slot_t::createAsync
+        proxy_t(const obj_desc_t &obj, GDBusProxy *created) : proxy(created), obj_name(obj.name) {
+            if (proxy)
+                alive()++;
+        }
+
+        // The number of the GDBusProxy objects alive. A proxy dropped from its slot stays
+        // alive until the calls holding it in their proxy_cache_t make their next call.
+        static std::atomic<size_t>& alive() { static std::atomic<size_t> n{ 0 }; return n; }
+
+        static GDBusProxyFlags flagsOf(const obj_desc_t &obj) {
+            using gdbus_client::GDBusObjectDescriptor;
+            unsigned flags = G_DBUS_PROXY_FLAGS_DO_NOT_CONNECT_SIGNALS; // The signals are not received via the proxy, but with the precise
+                                                                        //    match rules of signal_storage_t, see GDBusSignal::registerCallback.
+            if (!(obj.proxy_flags & GDBusObjectDescriptor::PROXY_LOAD_PROPERTIES))
+                flags |= G_DBUS_PROXY_FLAGS_DO_NOT_LOAD_PROPERTIES;
+            else                                                        // Fetch the values of the properties the service
+                flags |= G_DBUS_PROXY_FLAGS_GET_INVALIDATED_PROPERTIES; //    only invalidates, to keep them cached
+            if (obj.proxy_flags & GDBusObjectDescriptor::PROXY_DO_NOT_AUTO_START)
+                flags |= G_DBUS_PROXY_FLAGS_DO_NOT_AUTO_START;
+            return static_cast<GDBusProxyFlags>(flags);
+        }
+
+        bool verboseCheckNoErr(const char *func, unsigned line) const;
+
+        ~proxy_t() {
+            if (proxy)
+                alive()--;
+            g_clear_object(&proxy); // proxy == null is ok here
+        }
+
+        enum Policy { USE_EXISTING, RECREATE };
     };
 
 
-    // A D-Bus signal is represented as a call without input params
-    // So far not used
-    struct signal_t: call_t {
-        explicit signal_t(obj_desc_t obj, std::string sig_name)
-            : call_t{ std::move(obj), std::move(sig_name) }
-        {}
+    // owner_watch_t tracks the owner of a D-Bus object name with g_bus_watch_name. There is
+    // one watch per name, shared by the proxy slots of all the targets with this name. When
+    // the name loses its owner, the proxies in these slots are dropped. The watch callbacks
+    // are dispatched in the thread that runs waitAndProcessSignals, like the signals are.
+    struct owner_watch_t {
+        enum state_t { UNKNOWN, OWNED, VANISHED };  // UNKNOWN until the first watch callback is dispatched
+
+        const std::string name;
+        std::atomic<int> state{ UNKNOWN };
+        std::mutex mutex;                           // protects 'slots' and 'parked', and is used with 'changed'
+        std::condition_variable changed;            // notified on each change of 'state'
+        std::vector<std::weak_ptr<proxy_slot_t>> slots;
+        unsigned watch_id = 0;
+
+        struct parked_t {                           // an async call waiting for the name to get an owner
+            GMainContext *context;                  // the context to resume the call in
+            GSourceFunc resume;
+            void *call;
+        };
+        std::vector<parked_t> parked;
+
+        explicit owner_watch_t(const std::string &obj_name) : name{ obj_name } {
+            gcontext_switcher_t gcontext_switcher{};    // dispatch the callbacks in the signal loop
+            watch_id = g_bus_watch_name(G_BUS_TYPE_SYSTEM, name.c_str(),
+                                        G_BUS_NAME_WATCHER_FLAGS_NONE,
+                                        onAppeared, onVanished, this, nullptr);
+        }
+
+        static void onAppeared(GDBusConnection *, const char *, const char *, void *self) {
+            static_cast<owner_watch_t*>(self)->update(OWNED);
+        }
+        static void onVanished(GDBusConnection *, const char *, void *self) {
+            static_cast<owner_watch_t*>(self)->update(VANISHED);
+        }
+
+        void update(state_t new_state);             // Set the state, and drop the proxies when it is VANISHED
+
+        // Wait until the name has an owner, until the given time at most. Returns false on timeout.
+        // Only waits: the state changes when the thread iterating the signal loop dispatches
+        // the watch callbacks.
+        bool waitOwned(std::chrono::steady_clock::time_point until);
+
+        // Dispatch p.resume(p.call) in p.context when the name gets an owner; right away if
+        // it already has one.
+        void park(const parked_t &p) {
+            {
+                std::lock_guard<std::mutex> lock{ mutex };
+                if (state.load() != OWNED) {
+                    parked.push_back(p);
+                    return;
+                }
+            }
+            resume(p);
+        }
+
+        // Forget the parked call. Returns false if it is already being resumed.
+        bool unpark(void *call) {
+            std::lock_guard<std::mutex> lock{ mutex };
+            for (auto it = parked.begin(); it != parked.end(); ++it) {
+                if (it->call == call) {
+                    parked.erase(it);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static void resume(const parked_t &p) {
+            GSource *idle = g_idle_source_new();
+            g_source_set_callback(idle, p.resume, p.call, nullptr);
+            g_source_attach(idle, p.context);
+            g_source_unref(idle);
+        }
+
+        static std::shared_ptr<owner_watch_t> instanceFor(const std::string &obj_name) { // Reentrant
+            std::lock_guard<std::mutex> lock{ watchesMutex() };
+            auto &watch = watches()[obj_name];
+            if (!watch) {
+                watch = std::make_shared<owner_watch_t>(obj_name);
+            }
+            return watch;
+        }
+
+        // The table of the watches; never destroyed: the watch callbacks refer to them
+        static std::mutex& watchesMutex() { static std::mutex mutex; return mutex; }
+        static std::map<std::string, std::shared_ptr<owner_watch_t>>& watches() {
+            static std::map<std::string, std::shared_ptr<owner_watch_t>> w;
+            return w;
+        }
     };
 
 
-    //  call_storage_t keeps a map of the registered gdbus calls (of type call_t)
-    //  and provides access to this list via its member functions add, get and remove,
-    //  which are reentrant (protected by a shared mutex).
-    //
-    //  In addition to that, it monitors the reference count to the registered calls,
-    //  and prints an error message in case if the reference count is not as expected
-    //  during the lifetime of the gdbus calls. This helps to monitor incorrect multithreaded
-    //  access to the GDBusCall class; see 'Usage Details' section in GDBusClient.hpp.
+    // proxy_slot_t is the entry of the global table of proxies, one per D-Bus target.
+    // Once a call has resolved its slot, it keeps using it without the table lookup; the
+    // slots no call refers to any more are removed by evict. The proxy in the slot is
+    // replaced on RECREATE, and each replacement increments the generation of the slot;
+    // this is how the holders of the outdated proxy learn that they need to fetch the new
+    // one. The proxy is also dropped when it is evicted, see GDBusCall::setProxyCacheLimits.
+    struct proxy_slot_t: std::enable_shared_from_this<proxy_slot_t> {
+        const obj_desc_t &object;                   // interned
+        const unsigned connection;                  // the connection of connection_pool_t the proxy is created on
+        std::mutex mutex;                           // protects 'proxy'
+        std::shared_ptr<proxy_t> proxy;             // the current proxy of the slot; null until created
+        std::atomic<unsigned> generation{ 0 };      // incremented each time 'proxy' is replaced
+        std::atomic<int64_t> last_used{ 0 };        // the monotonic time of the last call, in us
+        std::atomic<bool> prewarming{ false };      // prewarm has started creating the proxy
+        const std::shared_ptr<owner_watch_t> owner; // the owner of the object name of the target
+
+        proxy_slot_t(const obj_desc_t &obj, unsigned connection)
+            :   object{ interned_t::object(obj) }, connection{ connection }, owner{ owner_watch_t::instanceFor(obj.name) }
+        {}
 
-    struct call_storage_t {
-        using call_ptr_t = std::shared_ptr<call_t>; // The registered calls are stored using shared pointers.
-                                                    // The use_count of the pointer helps to detect simultaneous modification
-                                                    //      of the output params from different threads.
-        struct call_guard_t {   // call_guard_t is a thin wrapper for shared_ptr<call_t> used to
-            call_ptr_t call;    //      check the value of use_count of the pointer with verboseCheckOwnership
+        // Drop the proxy; the next call through this slot creates a new one.
+        void invalidate() {
+            std::lock_guard<std::mutex> lock{ mutex };
+            if (proxy) {
+                proxy.reset();
+                generation++;
+            }
+        }
 
-            call_guard_t(call_guard_t &&g) noexcept :call{std::move(g.call)}
-            { g.call.reset(); }
+        // Return the current proxy of the slot, and its generation in 'gen'. Create the proxy
+        // if there is none, or recreate it on RECREATE, unless some other thread has already
+        // replaced the proxy of generation 'seen_gen'.
+        std::shared_ptr<proxy_t> get(const proxy_t::Policy policy, unsigned seen_gen, unsigned &gen) {
+            std::lock_guard<std::mutex> lock{ mutex };
+            const bool outdated = (policy == proxy_t::RECREATE && seen_gen == generation.load());
+            if (outdated || !proxy || !proxy->proxy) {
+                proxy = std::make_shared<proxy_t>(object, connection);
+                generation++;
+            }
+            gen = generation.load();
+            return proxy;
+        }
 
-            explicit call_guard_t(call_ptr_t &&ptr) :call{ptr} {}
+        // The same as get, but never creates the proxy: returns null where get would create it.
+        std::shared_ptr<proxy_t> peek(const proxy_t::Policy policy, unsigned seen_gen, unsigned &gen) {
+            std::lock_guard<std::mutex> lock{ mutex };
+            const bool outdated = (policy == proxy_t::RECREATE && seen_gen == generation.load());
+            if (outdated || !proxy || !proxy->proxy)
+                return nullptr;
+            gen = generation.load();
+            return proxy;
+        }
 
-            ~call_guard_t() {
-                if (!storage_destroyed) // if destroyed, there is only one owner left
-                    verboseCheckOwnership(2, AT()); // normally, there are two owners of the call: this guard and the calls map.
+        // Start creating the proxy asynchronously, to replace the proxy of generation seen_gen.
+        // The proxy created is adopted by onCreated, unless another one has replaced that proxy
+        // meanwhile. 'done' then receives whether the slot has a new proxy. The completion is
+        // dispatched in the thread-default context of the caller.
+        using created_t = std::function<void(bool ready)>;
+        void createAsync(unsigned seen_gen, created_t done) {
+            auto *creation = new creation_t{ shared_from_this(), seen_gen, std::move(done) };
+            if (connection == 0) {
+                g_dbus_proxy_new_for_bus(G_BUS_TYPE_SYSTEM, proxy_t::flagsOf(object), nullptr,
+                        object.name.c_str(), object.path.c_str(), object.iface.c_str(),
+                        nullptr, onCreated, creation);
+                return;
+            }
+            connection_pool.connectionAsync(connection, [creation](GDBusConnection *conn) {  // never blocks the loop
+                const obj_desc_t &object = creation->slot->object;
+                if (conn) {
+                    g_dbus_proxy_new(conn, proxy_t::flagsOf(object), nullptr,
+                            object.name.c_str(), object.path.c_str(), object.iface.c_str(),
+                            nullptr, onCreated, creation);
+                    return;
+                }
+                std::unique_ptr<creation_t> failed{ creation };
+                if (failed->done)
+                    failed->done(false);
+            });
+        }
+
+        // Start creating the proxy asynchronously, unless the slot already has one, or is
+        // already creating it. The proxy created is adopted in the signal loop.
+        void prewarm() {
+            unsigned seen_gen;
+            {
+                std::lock_guard<std::mutex> lock{ mutex };
+                if ((proxy && proxy->proxy) || prewarming.exchange(true))
+                    return;
+                seen_gen = generation.load();
             }
-            bool verboseCheckOwnership( unsigned n_owners,
-                                        const char *func, unsigned line);
+            gcontext_switcher_t gcontext_switcher{};    // dispatch onCreated in the signal loop
+            createAsync(seen_gen, [this](bool) { prewarming.store(false); });  // the creation keeps the slot alive
+        }
+
+    private:
+        struct creation_t {
+            std::shared_ptr<proxy_slot_t> slot;     // keeps the slot alive until the proxy is created
+            unsigned seen_gen;
+            created_t done;
         };
 
+        static void onCreated(GObject *, GAsyncResult *res, void *data) {
+            std::unique_ptr<creation_t> creation{ static_cast<creation_t*>(data) };
+            proxy_slot_t &slot = *creation->slot;
+            gerror_t err;
+            GDBusProxy *created = (slot.connection == 0) ?
+                    g_dbus_proxy_new_for_bus_finish(res, static_cast<GError**>(err)) :
+                    g_dbus_proxy_new_finish(res, static_cast<GError**>(err));
+            err.verboseCheckNoErr(AT());
+
+            bool ready = false;
+            {
+                std::lock_guard<std::mutex> lock{ slot.mutex };
+                const bool current = slot.proxy && slot.proxy->proxy;
+                if (current && slot.generation.load() != creation->seen_gen) {
+                    ready = true;                       // another one has replaced the proxy in the meantime
+                    if (created)
+                        g_object_unref(created);
+                }
+                else if (created) {
+                    slot.proxy = std::make_shared<proxy_t>(slot.object, created);
+                    slot.generation++;
+                    ready = true;
+                }
+            }
+            if (creation->done)
+                creation->done(ready);
+        }
+
+    public:
+        bool hasProxy() {
+            std::lock_guard<std::mutex> lock{ mutex };
+            return proxy && proxy->proxy;
+        }
+
+        // The proxies of the targets with the properties loaded receive PropertiesChanged,
+        // so they are kept for as long as the process runs, see property_cache_t.
+        bool evictable() const {
+            return !(object.proxy_flags & gdbus_client::GDBusObjectDescriptor::PROXY_LOAD_PROPERTIES);
+        }
+
+        static std::shared_ptr<proxy_slot_t> instanceFor(const obj_desc_t &obj,        // Reentrant
+                                                         unsigned connection = 0)
+        {
+            const slot_key_t target{ &interned_t::object(obj), connection };
+
+            std::lock_guard<std::mutex> lock{ slotsMutex() };
+            auto &slot = slots()[target];
+            if (!slot) {
+                slot = std::make_shared<proxy_slot_t>(obj, connection);
+                std::lock_guard<std::mutex> owner_lock{ slot->owner->mutex };
+                auto &owned = slot->owner->slots;
+                owned.erase(std::remove_if(owned.begin(), owned.end(),          // forget the slots removed by evict
+                                           [](const std::weak_ptr<proxy_slot_t> &s) { return s.expired(); }),
+                            owned.end());
+                owned.emplace_back(slot);
+            }
+            return slot;
+        }
+
+        // Drop the proxies unused for idle_usec (if not 0), then the least recently used ones
+        // above max_proxies (if not 0), and remove the slots no call refers to.
+        static void evict(size_t max_proxies, int64_t idle_usec);
+
+        // The table of the slots, by the interned target and the connection
+        using slot_key_t = std::pair<const obj_desc_t*, unsigned>;
+        static std::mutex& slotsMutex() { static std::mutex mutex; return mutex; }
+        static std::map<slot_key_t, std::shared_ptr<proxy_slot_t>>& slots() {
+            static std::map<slot_key_t, std::shared_ptr<proxy_slot_t>> s;
+            return s;
+        }
+    };
 
-        std::mutex call_mutex;   // protect the calls map from simultaneous modification and access
-        std::map<const gdbus_client::GDBusCall*, call_ptr_t> calls; // The map of the registered calls; shared between threads.
-        static std::atomic_bool storage_destroyed;  // Prevents access to the destoryed call_storage_t from other threads.
-                                                    // It is set to false only when the application exits.
 
-        void add(const gdbus_client::GDBusCall* p, call_t && call) {
-            if (verboseStateCheck(AT())) {          // Avoid accessing 'this->call_mutex' after the end of life of 'this'.
-                                                    // The 'else' clause here should never happen as long as the threads
-                                                    // that use this client are joined before application exit.
-                std::lock_guard<std::mutex> lock{call_mutex};
-                calls.emplace(p, std::make_shared<call_t>(std::move(call)));
+    void proxy_slot_t::evict(size_t max_proxies, int64_t idle_usec) {
+        std::vector<std::shared_ptr<proxy_slot_t>> live, dropped;   // the proxies are destroyed without the table lock
+        {
+            std::lock_guard<std::mutex> lock{ slotsMutex() };
+            auto &table = slots();
+            for (auto i = table.begin(); i != table.end();) {
+                proxy_slot_t &slot = *i->second;
+                if (i->second.use_count() == 1 && !slot.hasProxy()) {
+                    i = table.erase(i);                             // unused, and nothing to keep
+                    continue;
+                }
+                if (slot.evictable() && slot.hasProxy())
+                    live.push_back(i->second);
+                ++i;
             }
         }
+        const int64_t now = g_get_monotonic_time();
+        std::sort(live.begin(), live.end(),                         // the least recently used first
+                  [](const std::shared_ptr<proxy_slot_t> &a, const std::shared_ptr<proxy_slot_t> &b) {
+                      return a->last_used.load(std::memory_order_relaxed) < b->last_used.load(std::memory_order_relaxed);
+                  });
+        size_t n = live.size();
+        for (auto &slot: live) {
+            const bool idle = idle_usec && now - slot->last_used.load(std::memory_order_relaxed) >= idle_usec;
+            if (!idle && (!max_proxies || n <= max_proxies))
+                break;
+            dropped.push_back(std::move(slot));
+            n--;
+        }
+        for (const auto &slot: dropped)
+            slot->invalidate();
+    }
+
+
+    // proxy_limits_t keeps the limits of GDBusCall::setProxyCacheLimits. The idle proxies
+    // are evicted by a timer in the signal loop; the number of proxies is also checked each
+    // time a call obtains a proxy from its slot.
+    struct proxy_limits_t {
+        std::atomic<unsigned> max_proxies{ 0 };     // 0 if not limited
+        std::atomic<int64_t> idle_usec{ 0 };        // 0 if not limited
+        std::mutex mutex;                           // protects 'sweeper'
+        GSource *sweeper = nullptr;                 // the timer evicting the idle proxies
+
+        void enforceMax() {
+            if (const unsigned max = max_proxies.load(std::memory_order_relaxed))
+                proxy_slot_t::evict(max, 0);
+        }
 
-        call_guard_t get(const gdbus_client::GDBusCall* p) {
-            if (verboseStateCheck(AT())) {
-                std::lock_guard<std::mutex> lock{call_mutex};
-                call_guard_t guard{std::move(calls[p])};
-                if (guard.verboseCheckOwnership(2, AT()))   // Protect against overlapped calls from different threads:
-                    return std::move(guard);                //      there should be two owners of guard.call at this moment.
+        static int onSweep(void *self) {
+            auto &limits = *static_cast<proxy_limits_t*>(self);
+            proxy_slot_t::evict(limits.max_proxies.load(), limits.idle_usec.load());
+            return G_SOURCE_CONTINUE;
+        }
+    }
+    proxy_limits;
+
+
+    void owner_watch_t::update(state_t new_state) {
+        std::vector<std::shared_ptr<proxy_slot_t>> vanished;
+        std::vector<parked_t> resumed;
+        {
+            std::lock_guard<std::mutex> lock{ mutex };
+            state.store(new_state);
+            if (new_state == VANISHED) {
+                for (const auto &slot: slots) {
+                    if (auto p = slot.lock()) {
+                        vanished.push_back(std::move(p));
+                    }
+                }
+            }
+            else if (new_state == OWNED) {
+                resumed.swap(parked);
             }
-            return call_guard_t{call_ptr_t()};              // Return an empty pointer on error; the caller must check it.
         }
+        changed.notify_all();
+        for (const auto &p: resumed) {
+            resume(p);
+        }
+        for (const auto &slot: vanished) {          // The proxies are destroyed outside of the watch lock
+            slot->invalidate();
+        }
+    }
+
 
-        void remove(const gdbus_client::GDBusCall* p) {
-            if (verboseStateCheck(AT())) {
-                std::lock_guard<std::mutex> lock{call_mutex};
-                calls.erase(p);
+    // proxy_cache_t is a per-call handle to the proxy of the call target. The slot is
+    // resolved once, on the first use, and then the cached proxy is re-validated with an
+    // atomic load of the slot generation; no locks are taken and nothing is allocated
+    // unless the proxy has to be (re)created. The owner of the call is the only user
+    // of its cache, see call_storage_t.
+    struct proxy_cache_t {
+        std::shared_ptr<proxy_slot_t> slot;
+        std::shared_ptr<proxy_t> proxy;
+        unsigned generation = 0;                    // the generation of the slot 'proxy' was obtained from
+
+        proxy_slot_t& slotFor(const obj_desc_t &obj) {
+            if (!slot) {
+                slot = proxy_slot_t::instanceFor(obj);
             }
+            return *slot;
         }
-        ~call_storage_t() {
-            storage_destroyed.store(true);
+
+        proxy_t& get(const obj_desc_t &obj, const proxy_t::Policy policy) {
+            slotFor(obj);
+            slot->last_used.store(g_get_monotonic_time(), std::memory_order_relaxed);
+            if (policy == proxy_t::RECREATE || !proxy || !proxy->proxy ||
+                generation != slot->generation.load(std::memory_order_acquire))
+            {
+                proxy = slot->get(policy, generation, generation);
+                proxy_limits.enforceMax();
+            }
+            return *proxy;
         }
 
-        static bool verboseStateCheck(const char *func, unsigned line);
+        // The same as get, but returns null instead of creating the proxy, see proxy_slot_t::createAsync
+        proxy_t* peek(const obj_desc_t &obj, const proxy_t::Policy policy) {
+            slotFor(obj);
+            slot->last_used.store(g_get_monotonic_time(), std::memory_order_relaxed);
+            if (policy != proxy_t::RECREATE && proxy && proxy->proxy &&
+                generation == slot->generation.load(std::memory_order_acquire))
+                return proxy.get();
+            unsigned gen;
+            auto current = slot->peek(policy, generation, gen);
+            if (!current)
+                return nullptr;
+            proxy = std::move(current);
+            generation = gen;
+            proxy_limits.enforceMax();
+            return proxy.get();
+        }
+    };
+
+
+    // property_cache_t is the handle of a GDBusProperty to the properties cached by the proxy
+    // of its target. The proxy is created with the properties loaded, so GLib fetches them
+    // with GetAll and then applies PropertiesChanged in the signal loop; reading a property
+    // is a lookup in the proxy under its lock. Unlike proxy_cache_t, the handle is shared by
+    // the threads reading the property, hence the mutex.
+    struct property_cache_t {
+        obj_desc_t object;
+        std::mutex mutex;                           // protects 'proxy_cache'
+        proxy_cache_t proxy_cache;
+
+        explicit property_cache_t(obj_desc_t obj) : object{ std::move(obj) } {
+            object.proxy_flags |= gdbus_client::GDBusObjectDescriptor::PROXY_LOAD_PROPERTIES;
+            proxy_cache.slotFor(object).prewarm();  // GetAll ahead of the first read
+        }
+
+        // Return a new reference to the cached value of the property, or null. Never waits for
+        // the proxy: if there is none, e.g. after it is dropped, it is recreated asynchronously,
+        // and the reads fail until the properties are loaded.
+        GVariant* cached(const char *name) {
+            std::lock_guard<std::mutex> lock{ mutex };
+            proxy_t *proxy = proxy_cache.peek(object, proxy_t::USE_EXISTING);
+            if (!proxy) {
+                proxy_cache.slot->prewarm();
+                return nullptr;
+            }
+            return g_dbus_proxy_get_cached_property(proxy->proxy, name);
+        }
+    };
+
+
+    // variant_holder_t keeps references to the variants it has adopted and releases them
+    // on destruction or on release(). release() keeps the capacity, so a holder stored in
+    // call_t is reused by the subsequent calls without reallocating.
+    struct variant_holder_t: public std::vector<GVariant *> {
+        variant_holder_t() = default;
+        variant_holder_t(const variant_holder_t&) = delete;
+        variant_holder_t(variant_holder_t&&) = default;
+
+        bool adopt(GVariant *v) {
+            if (v)
+                push_back(g_variant_take_ref(v));
+            return static_cast<bool>(v);
+        }
+
+        GVariant* to_tuple() {
+            return g_variant_new_tuple( empty()? nullptr : &front(), size() );
+        }
+
+        void release() {
+            std::for_each(begin(), end(),
+                [](GVariant *v){ if (v) g_variant_unref(v);}) ;
+            clear();
+        }
+
+        ~variant_holder_t() { release(); }
+    };
+
+
+    // fd_list_t owns the fd list sent with a message or received with a reply, see TYPE_H
+    struct fd_list_t {
+        GUnixFDList *list = nullptr;
+
+        fd_list_t() = default;
+        fd_list_t(const fd_list_t&) = delete;
+        ~fd_list_t() { g_clear_object(&list); }
+    };
+
+
+    // metrics_t holds the metrics of a D-Bus target and member (a method or a signal), see
+    // GDBusMetrics. The instances are registered on the first use of the target and member,
+    // and never destroyed, so the calls and subscriptions keep plain pointers to them.
+    // Only relaxed atomic increments are done on the hot paths.
+    struct metrics_t {
+        using counter_t = std::atomic<uint64_t>;
+        using GDBusMetrics = gdbus_client::GDBusMetrics;
+        using clock = std::chrono::steady_clock;
+
+        struct histogram_t {
+            counter_t counts[GDBusMetrics::histogram_t::BUCKETS] = {};
+            counter_t samples{ 0 };
+            counter_t total_us{ 0 };
+
+            void add(clock::duration d) {
+                const uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+                unsigned bucket = 0;
+                while (bucket + 1 < GDBusMetrics::histogram_t::BUCKETS && (us >> bucket) != 0)
+                    bucket++;
+                counts[bucket].fetch_add(1, std::memory_order_relaxed);
+                samples.fetch_add(1, std::memory_order_relaxed);
+                total_us.fetch_add(us, std::memory_order_relaxed);
+            }
+
+            void copyTo(GDBusMetrics::histogram_t &h) const {
+                for (unsigned i = 0; i < GDBusMetrics::histogram_t::BUCKETS; i++)
+                    h.counts[i] = counts[i].load(std::memory_order_relaxed);
+                h.samples = samples.load(std::memory_order_relaxed);
+                h.total_us = total_us.load(std::memory_order_relaxed);
+            }
+        };
+
+        // Adds the time from its construction to its destruction to the histogram
+        struct timer_t {
+            histogram_t &histogram;
+            const clock::time_point start = clock::now();
+            ~timer_t() { histogram.add(clock::now() - start); }
+        };
+
+        const obj_desc_t &object;                   // interned
+        const std::string &member;                  // interned
+        counter_t calls{ 0 }, failures{ 0 }, retries{ 0 }, proxy_recreations{ 0 }, signals{ 0 };
+        counter_t errors[GDBusMetrics::ERROR_KINDS] = {};
+        histogram_t marshal, round_trip, unmarshal, dispatch;
+
+        metrics_t(const obj_desc_t &obj, const std::string &member)
+            :   object{ interned_t::object(obj) }, member{ interned_t::name(member) }
+        {}
+
+        static void count(counter_t &counter) { counter.fetch_add(1, std::memory_order_relaxed); }
+
+        void countError(const gerror_t &err) {
+            static_assert(gerror_t::UNSPECIFIED - gerror_t::SERVICE_UNKNOWN == GDBusMetrics::ERROR_UNSPECIFIED,
+                          "GDBusMetrics::error_t should follow gerror_t::errcode_t");
+            const auto type = err.errType();
+            if (type != gerror_t::NOERR)
+                count(errors[type - gerror_t::SERVICE_UNKNOWN]);
+        }
+
+        void copyTo(GDBusMetrics::entry_t &e) const {
+            e.obj_name = object.name;
+            e.obj_path = object.path;
+            e.iface_name = object.iface;
+            e.member = member;
+            e.calls = calls.load(std::memory_order_relaxed);
+            e.failures = failures.load(std::memory_order_relaxed);
+            e.retries = retries.load(std::memory_order_relaxed);
+            e.proxy_recreations = proxy_recreations.load(std::memory_order_relaxed);
+            e.signals = signals.load(std::memory_order_relaxed);
+            for (unsigned i = 0; i < GDBusMetrics::ERROR_KINDS; i++)
+                e.errors[i] = errors[i].load(std::memory_order_relaxed);
+            marshal.copyTo(e.marshal);
+            round_trip.copyTo(e.round_trip);
+            unmarshal.copyTo(e.unmarshal);
+            dispatch.copyTo(e.dispatch);
+        }
+
+        // The registry of all the metrics; the lock is taken only on registration and on snapshots
+        static std::mutex& registryMutex() { static std::mutex mutex; return mutex; }
+        static std::map<std::string, std::unique_ptr<metrics_t>>& registry() {
+            static std::map<std::string, std::unique_ptr<metrics_t>> metrics;
+            return metrics;
+        }
+
+        static metrics_t* instanceFor(const obj_desc_t &obj, const std::string &member) { // Reentrant
+            const std::string key = obj.name + " " + obj.path + " " + obj.iface + " " + member;
+            std::lock_guard<std::mutex> lock{ registryMutex() };
+            auto &m = registry()[key];
+            if (!m)
+                m.reset(new metrics_t{ obj, member });
+            return m.get();
+        }
+    };
+
+
+    // call_desc_t is the static description of a call: its target, its method and the layout
+    // of its params. The description is built by the first instance of a GDBusCall descendant,
+    // and then published to be shared by the instances of the same type constructed later in
+    // the same thread; see call_t. A published description is immutable, except for the members
+    // computed on the first use, which are initialized exactly once.
+    // A D-Bus signal is represented as a call without input params; the body of the signal
+    // is unmarshalled into its output params the same way as the reply to a call is.
+    struct call_desc_t {
+        const obj_desc_t &object;                   // target of the call; interned
+        const std::string &method;                  // the target method; interned
+        const bool from_name;                       // the target was given by the object name only
+        std::vector<param_t> params;                // in and out parameters that belong to this call,
+                                                    //      located relative to the call instance
+        std::once_flag used;                        // initializes the members below on the first use
+        std::string reply_sig;                      // the expected prefix of the reply type, see verboseCheckReplyType
+        metrics_t *metrics = nullptr;               // the metrics of the target and method
+        bool has_fds = false;                       // some param is TYPE_H: the messages carry fd lists
+
+        call_desc_t(const obj_desc_t &obj, const std::string &method, bool from_name)
+            :   object{ interned_t::object(obj) }, method{ interned_t::name(method) }, from_name{ from_name }
+        {}
+
+        // Whether the description is of the target given to the GDBusCall ctor; obj is null
+        // if the target is given by obj_name.
+        bool matches(const char *obj_name,
+                     const gdbus_client::GDBusObjectDescriptor *obj,
+                     const char *method_name) const;
+
+        bool sameTarget(const call_desc_t &d) const {
+            return  &method == &d.method && &object == &d.object && from_name == d.from_name;  // interned
+        }
+
+        bool verboseCheckNoErr(const char *func, unsigned line);
+    };
+
+
+    // The key of the published call descriptions: the addresses of the target (the object name
+    // or the GDBusObjectDescriptor) and of the method name, as given to the GDBusCall ctor.
+    // Those are normally literals or statics, so the addresses identify the GDBusCall
+    // descendant well enough; the contents are verified anyway. Several descendants may
+    // share the literals (merged by the linker) with different params, so a key holds up to
+    // MAX_DESCS_PER_KEY descriptions, told apart by their params as the instance binds them.
+    using desc_key_t = std::pair<const void*, const char*>;
+
+    struct desc_key_hash_t {
+        size_t operator()(const desc_key_t &k) const {
+            return std::hash<const void*>()(k.first) * 31 + std::hash<const void*>()(k.second);
+        }
+    };
+
+    // call_t is the state of a GDBusCall or GDBusSignal instance, owned by the instance.
+    // While the instance is constructed, its params either confirm the published description
+    // of the same type, one by one, or all go into a private description ('building'), which
+    // is published on the first use of the instance. Thus, after the first instance of a type,
+    // constructing a call allocates only the call_t, and takes no locks.
+    struct call_t {
+        std::shared_ptr<call_desc_t> desc;          // the description; shared if published
+        char *const base;                           // the GDBusCall or GDBusSignal instance holding the param values
+        const desc_key_t key;                       // the target and method as given to the ctor; keys the published descriptions
+        size_t bound = 0;                           // the number of params of a shared desc confirmed by this instance
+        bool building = true;                       // desc is private and under construction
+        proxy_cache_t proxy_cache;                  // the proxy of the target, resolved on the first call
+        bool has_policy = false;                    // if false, the call uses the default policy
+        gdbus_client::GDBusCallPolicy policy;
+        variant_holder_t in_variants;               // scratch buffer for marshalling; kept between the calls to reuse its capacity
+        coalescer_t *coalescer = nullptr;           // the coalescer of the target and method, once callOneWay is used
+        std::atomic<bool> in_flight{ false };       // the call is being used, see call_storage_t
+        std::mutex instance_mutex;                  // held by async calls while they access the params of the instance
+        bool detached = false;                      // the params must not be touched anymore, see GDBusCall::cancelAsync;
+                                                    //      guarded by instance_mutex. The call_t outlives the instance.
+
+        call_t(void *base, const char *obj_name,
+               const gdbus_client::GDBusObjectDescriptor *obj,
+               const char *method);
+
+        void bind(param_t &&param);                 // add a param of the instance under construction
+        call_desc_t& seal(bool calls);              // make the instance ready for use; called on each use. The proxy slot
+                                                    //      is only resolved for 'calls', not for the signals.
+        void* valueOf(const param_t &param) const;  // the GDBusParam of the instance described by param
+
+    private:
+        void fork(size_t n_params);                 // make a private copy of desc with its first n_params
+        bool switchTo(const param_t *next);         // adopt another published desc with the same 'bound' params, then
+                                                    //      'next' if given, or no more params if null
+    };
+
+
+    //  call_storage_t gives access to the call_t of the GDBusCall and GDBusSignal instances.
+    //  Each instance owns its call_t via an opaque pointer, so there is no registry of
+    //  the calls shared between threads, and no locking.
+    //
+    //  In addition to that, it detects the simultaneous use of the same call: the call is
+    //  marked as in flight while it is used, and an error message is printed if another
+    //  use of the same call begins meanwhile. This helps to monitor incorrect multithreaded
+    //  access to the GDBusCall class; see 'Usage Details' section in GDBusClient.hpp.
+    //  Only the flag of the call itself is touched, so independent calls in different
+    //  threads never contend.
+    struct call_storage_t {
+        struct call_guard_t {   // call_guard_t marks the call as in flight during its lifetime
+            call_t *call;
+
+            call_guard_t(call_guard_t &&g) noexcept :call{g.call}
+            { g.call = nullptr; }
+
+            explicit call_guard_t(call_t *call = nullptr) :call{call} {}
+
+            ~call_guard_t() {
+                if (call)
+                    call->in_flight.store(false, std::memory_order_release);
+            }
+        };
+
+        // Create the call_t of the instance. The call_t and the control block of its shared_ptr
+        // are allocated at once; the state stays opaque in GDBusClient.hpp, so it is not embedded
+        // in the instance itself.
+        template<typename C>
+        call_t* add(C *p, const char *obj_name, const gdbus_client::GDBusObjectDescriptor *obj, const char *method) {
+            auto state = std::make_shared<call_t>(p, obj_name, obj, method);
+            call_t *call = state.get();
+            gdbus_client::GDBusCallAccess::state(*p) = std::move(state);
+            return call;
+        }
+
+        template<typename C>
+        call_guard_t get(const C *p) {
+            call_t *call = static_cast<call_t*>(gdbus_client::GDBusCallAccess::state(*p).get());
+            if (call && verboseCheckNotInFlight(AT(), *call)) { // Protect against overlapped calls from different threads
+                call->seal(!std::is_base_of<gdbus_client::GDBusSignal, C>::value);
+                return call_guard_t{ call };
+            }
+            return call_guard_t{};                              // Return an empty guard on error; the caller must check it.
+        }
+
+        // Mark the call as in flight; fails if it already is.
+        static bool verboseCheckNotInFlight(const char *func, unsigned line, call_t &call);
     }
     calls;
 
 
-    // storage_destroyed monitors the lifetime of the call_storage_t instance
-    // and is used to prevent access to the call_storage_t instance after it was
-    // destroyed. This might happen in the situation when another (detached) thread
-    // tries to access the storage while the process is shutting down. This should
-    // not happen in production (other threads should be properly joined before
-    // the destruction of statics begin), but is a typical scenario in tests.
-    std::atomic_bool call_storage_t::storage_destroyed { false };
-
     struct param_t {
         const char *name;       // Kept for error reporting and introspection
         const char *type;       // Kept for error reporting and introspection
 
-        std::function<GVariant*()>      marshal;    // The marshaller, to convert 'in' parameters into GVariant fields in D-Bus messages
-        std::function<bool(GVariant *)> unmarshal;  // The unmarshaller, to decode 'out' parameter values from GVariant
-                                                    // For each parameter instance, only one of those two is defined.
-        std::function<void()>           cleanup;    // The cleanup function, to zero out the 'out' parameters on error.
+        // The converters are bound to the GDBusParam type at compile time: each pointer refers to
+        // an instantiation of a thunk below, which casts 'par' back to its GDBusParam type and calls
+        // the converter directly. Thus, no closures are allocated, and each param is converted with
+        // a plain function call.
+        std::ptrdiff_t offset = 0;                      // The location of the GDBusParam relative to the call instance
+        GVariant* (*marshal)(const void *par) = nullptr;// The marshaller, to convert 'in' parameters into GVariant fields in D-Bus messages
+        bool (*unmarshal)(void *par, GVariant *) = nullptr; // The unmarshaller, to decode 'out' parameter values from GVariant
+                                                        // For each parameter instance, only one of those two is defined.
+        void (*cleanup)(void *par) = nullptr;           // The cleanup function, to zero out the 'out' parameters on error.
+        void (*discard)(void *par) = nullptr;           // Releases the value unmarshalled by a call that fails afterwards,
+                                                        //      i.e. closes the fd duplicated for TYPE_H; see unmarshalOutParams.
         using PARAM_IN  = gdbus_client::GDBusDirection::PARAM_IN;
         using PARAM_OUT = gdbus_client::GDBusDirection::PARAM_OUT;
         using GDBusCall = gdbus_client::GDBusCall;
@@ -278,36 +1167,105 @@ namespace {
         template<typename ParamT, typename ValueT>                      // The ctor for 'in' parameters. Uses the marshaller only
         param_t( GDBusCall::GDBusParam<ParamT, PARAM_IN, ValueT> *par,  // and does not require the unmarshaller in compile time.
                 const char *name, const char *type, ValueT v)           // 'v' is the default value of the parameter
-            :   name(name), type(type), cleanup{ []{/*do nothing for 'in'*/} }
+            :   name(name), type(type)
         {
             if (!verboseCheckNoErr(AT(), par, callUnderConstruction))   // ignore parameters that fail to satisfy pre-conditions
                 return;
+            offset = reinterpret_cast<char*>(par) - callUnderConstruction->base;
             par->value = std::move(v);                                  // set the initial value of the 'in' parameter
-            marshal = [par]() { return                                  // Capture the pointer to the GDBusParam: it is used by the marshaller
-                gdbus_client::converters::marshal(ParamT(), par->value); }; // to retrieve the input value.
+            marshal = &marshalThunk<ParamT, ValueT>;
         }
 
         template<typename ParamT,  typename ValueT>                     // The ctor for 'out' parameters. Only uses the unmarshaller;
         param_t( GDBusCall::GDBusParam<ParamT, PARAM_OUT, ValueT> *par, // does not need the marshaller, even in compile time.
                  const char *name, const char *type, ValueT v)
-            :   name(name), type(type), cleanup{ [par]{par->value = {}; } }
+            :   name(name), type(type)
         {
             if (!verboseCheckNoErr(AT(), par, callUnderConstruction))   // ignore parameters that fail to satisfy pre-conditions
                 return;
+            offset = reinterpret_cast<char*>(par) - callUnderConstruction->base;
+            cleanup = &cleanupThunk<ParamT, ValueT>;
+            discard = &discardThunk<ParamT, ValueT>;
             par->value = std::move(v);
-            unmarshal = [par](GVariant *v) { return                     // Capture the pointer to the GDBusParam: it is used by the unmarshaller
-                gdbus_client::converters::unmarshal(ParamT(), v, par->value); };// to store the output value.
+            unmarshal = &unmarshalThunk<ParamT, ValueT>;
+        }
+
+        param_t( gdbus_client::GDBusStructParam *par,                   // The ctor for the params of the mapped structs, see
+                 const char *name, bool in)                             //      GDBUS_STRUCT. The struct layout provides the type.
+            :   name(name),
+                type(par->array ? par->layout.array_signature.c_str() : par->layout.signature.c_str())
+        {
+            if (!verboseCheckNoErr(AT(), par, callUnderConstruction))
+                return;
+            offset = reinterpret_cast<char*>(par) - callUnderConstruction->base;
+            if (in) {
+                marshal = [](const void *p) {
+                    return gdbus_client::converters::marshal(*static_cast<const gdbus_client::GDBusStructParam*>(p));
+                };
+            }
+            else {
+                unmarshal = [](void *p, GVariant *v) {
+                    return gdbus_client::converters::unmarshal(*static_cast<gdbus_client::GDBusStructParam*>(p), v);
+                };
+                cleanup = [](void *p) {
+                    auto *par = static_cast<gdbus_client::GDBusStructParam*>(p);
+                    if (par->array)
+                        par->layout.resize(par->value(par), 0);
+                    else
+                        par->layout.reset(par->value(par));
+                };
+            }
+        }
+
+        template<typename ParamT, typename ValueT>
+        static GVariant* marshalThunk(const void *par) {
+            using par_t = GDBusCall::GDBusParam<ParamT, PARAM_IN, ValueT>;
+            return gdbus_client::converters::marshal(ParamT(), static_cast<const par_t*>(par)->value);
+        }
+
+        template<typename ParamT, typename ValueT>
+        static bool unmarshalThunk(void *par, GVariant *v) {
+            using par_t = GDBusCall::GDBusParam<ParamT, PARAM_OUT, ValueT>;
+            return gdbus_client::converters::unmarshal(ParamT(), v, static_cast<par_t*>(par)->value);
+        }
+
+        template<typename ParamT, typename ValueT>
+        static void cleanupThunk(void *par) {
+            using par_t = GDBusCall::GDBusParam<ParamT, PARAM_OUT, ValueT>;
+            clearValue(ParamT(), static_cast<par_t*>(par)->value);
+        }
+
+        template<typename ParamT, typename ValueT>
+        static void discardThunk(void *par) {
+            using par_t = GDBusCall::GDBusParam<ParamT, PARAM_OUT, ValueT>;
+            discardValue(ParamT(), static_cast<par_t*>(par)->value);
+        }
+
+        template<typename ParamT, typename ValueT>
+        static void clearValue(ParamT, ValueT &value) { value = {}; }
+        static void clearValue(gdbus_client::GDBusType::TYPE_H, int &fd) { fd = -1; }   // 0 would be a valid descriptor
+
+        template<typename ParamT, typename ValueT>
+        static void discardValue(ParamT, ValueT &) {}                   // The cleanup that follows resets the value
+        static void discardValue(gdbus_client::GDBusType::TYPE_H, int &fd) {
+            if (fd >= 0)
+                close(fd);
+            fd = -1;
         }
 
-        void moveIntoCall() && {                                        // Consume this param_t instance and move it into the 'calls' map.
-            auto call_guard = calls.get(callUnderConstruction);
-            if (call_guard.call)
-                call_guard.call->params.emplace_back(std::move(*this));
+        void moveIntoCall() && {                                        // Consume this param_t instance and bind it to the call
+            if (marshal || unmarshal)                                   //      under construction, unless it failed the checks.
+                callUnderConstruction->bind(std::move(*this));
+        }
+
+        bool sameAs(const param_t &p) const {                           // The same param of the same GDBusCall descendant
+            return  offset == p.offset && name == p.name && type == p.type &&
+                    marshal == p.marshal && unmarshal == p.unmarshal && cleanup == p.cleanup;
         }
 
         static bool verboseCheckNoErr(  const char *func, unsigned line, // Check whether param is a member field in a call struct
                                         const void *gdbus_par,
-                                        const GDBusCall *call);
+                                        const call_t *call);
 
         bool verboseCheckMarshalled(    const char *func, unsigned line,
                                         GVariant *v) const;
@@ -317,230 +1275,1074 @@ namespace {
     };
 
 
-    struct signal_storage_t {
+    // The descriptions published in this thread; see desc_key_t.
+    const size_t MAX_DESCS_PER_KEY = 8;
+    using published_descs_t = std::unordered_map<desc_key_t, std::vector<std::shared_ptr<call_desc_t>>, desc_key_hash_t>;
 
-        std::mutex signals_mutex;
-        std::map<std::string,
-                 std::vector<gdbus_client::GDBusSignal::callback_t>>
-                signal_map;
+    published_descs_t& publishedDescs() {
+        thread_local published_descs_t descs;
+        return descs;
+    }
 
-        static const std::string key(const std::string &sender_name,
-                         const std::string &sig_name)
-        {
-            return sender_name + " " + sig_name;
+    bool call_desc_t::matches(const char *obj_name,
+                              const gdbus_client::GDBusObjectDescriptor *obj,
+                              const char *method_name) const
+    {
+        return method == method_name && (obj ?
+                !from_name && object.name == obj->obj_name &&
+                        object.path == obj->obj_path && object.iface == obj->iface_name :
+                from_name && object.name == obj_name);
+    }
+
+    call_t::call_t(void *base, const char *obj_name,
+                   const gdbus_client::GDBusObjectDescriptor *obj,
+                   const char *method)
+        :   base{ static_cast<char*>(base) },
+            key{ obj ? static_cast<const void*>(obj) : static_cast<const void*>(obj_name), method }
+    {
+        std::shared_ptr<call_desc_t> candidate;                     // Start with the first published one; bind
+        const auto published = publishedDescs().find(key);          //      switches to another if the params differ
+        if (published != publishedDescs().end()) {
+            for (const auto &d: published->second) {
+                if (d->matches(obj_name, obj, method)) {
+                    candidate = d;
+                    break;
+                }
+            }
+        }
+        if (candidate) {
+            desc = std::move(candidate);
+            building = false;
+        }
+        else {
+            desc = std::make_shared<call_desc_t>(
+                    obj ? obj_desc_t::fromDesc(*obj) : obj_desc_t::fromName(obj_name), method, !obj);
+            desc->verboseCheckNoErr(AT());
         }
+    }
 
-        void add(const obj_desc_t &sender,
+    void call_t::bind(param_t &&param) {
+        if (!building) {
+            if ((bound < desc->params.size() && desc->params[bound].sameAs(param)) || switchTo(&param)) {
+                bound++;
+                return;
+            }
+            fork(bound);        // This instance differs from all the ones that published a desc
+        }
+        desc->params.emplace_back(std::move(param));
+    }
+
+    bool call_t::switchTo(const param_t *next) {
+        const auto published = publishedDescs().find(key);
+        if (published == publishedDescs().end())
+            return false;
+        for (const auto &d: published->second) {
+            const size_t n = bound + (next ? 1 : 0);
+            bool same = d != desc && d->sameTarget(*desc) &&
+                        (next ? d->params.size() >= n : d->params.size() == n);
+            for (size_t i = 0; same && i < bound; i++)
+                same = d->params[i].sameAs(desc->params[i]);
+            if (same && (!next || d->params[bound].sameAs(*next))) {
+                desc = d;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void call_t::fork(size_t n_params) {
+        auto copy = std::make_shared<call_desc_t>(desc->object, desc->method, desc->from_name);
+        copy->params.assign(desc->params.begin(), desc->params.begin() + n_params);
+        desc = std::move(copy);
+        building = true;
+    }
+
+    call_desc_t& call_t::seal(bool calls) {
+        if (!building && bound != desc->params.size() && !switchTo(nullptr))
+            fork(bound);        // This instance has fewer params than the ones that published a desc
+        if (building) {
+            auto &published = publishedDescs()[key];
+            if (published.size() < MAX_DESCS_PER_KEY)               // Keep the first ones published; the
+                published.push_back(desc);                          //      instances of the others fork
+            building = false;
+            bound = desc->params.size();
+        }
+        call_desc_t &d = *desc;
+        std::call_once(d.used, [&d]() {
+            d.reply_sig = "(";
+            for (const param_t &param: d.params) {
+                if (param.unmarshal)
+                    d.reply_sig += param.type;
+                if (std::strchr(param.type, 'h'))
+                    d.has_fds = true;
+            }
+            const std::string tuple_sig = d.reply_sig + ")";
+            if (!g_variant_type_string_is_valid(tuple_sig.c_str()) ||
+                !g_variant_type_is_definite(G_VARIANT_TYPE(tuple_sig.c_str())))
+                d.reply_sig.clear();
+            d.metrics = metrics_t::instanceFor(d.object, d.method);
+        });
+        if (!calls)                                                 // The signals need no proxy, nor the owner watch
+            return d;                                               //      of a slot; see signal_storage_t
+        const unsigned conn = connection_pool.connectionOfThisThread();  // The connection of the calling thread,
+        if (!proxy_cache.slot || proxy_cache.slot->connection != conn) { //      with the current size of the pool
+            proxy_cache.slot = proxy_slot_t::instanceFor(d.object, conn);
+            proxy_cache.proxy.reset();
+            proxy_cache.generation = 0;
+        }
+        return d;
+    }
+
+    void* call_t::valueOf(const param_t &param) const {
+        return base + param.offset;
+    }
+
+
+    //  signal_storage_t is the registry of the signal handlers. Each distinct combination
+    //  of the sender, object path, interface, signal name and, optionally, the first
+    //  argument of the signal is a subscription_t, which installs the corresponding match
+    //  rule on the bus with g_dbus_connection_signal_subscribe. Therefore, the bus daemon
+    //  delivers to this process only the signals somebody has subscribed to.
+    //
+    //  The registry is organized for dispatching, which is much more frequent than
+    //  registering: the subscription is passed to the signal callback, so it needs no
+    //  lookup, and it keeps an immutable list of handlers that is replaced as a whole
+    //  (copy-on-write) when a handler is added or removed. Therefore onSignal takes an
+    //  atomic snapshot of the list, without locking or allocating anything; the handlers
+    //  of the snapshot stay alive until the dispatch is over, even if removed meanwhile.
+    struct signal_storage_t {
+
+        // A registered signal handler receives the body of the signal. The handlers of
+        // GDBusSignal instances unmarshal it into the instance; the callbacks registered
+        // with GDBusSignal::registerCallback ignore it.
+        using handler_t = std::function<void(const char *sender_name,
+                                             const char *signal_name,
+                                             GVariant *parameters)>;
+        // The gate of a GDBusSignal instance lets one of its handlers run at a time, in any
+        // thread, and lets remove wait for the handler running; see dispatch.
+        struct owner_gate_t {
+            std::recursive_mutex mutex;     // held while a handler of the instance runs; recursive, so that
+                                            //      a handler may destroy its own instance
+            bool removed = false;           // the instance is destroyed; guarded by mutex
+        };
+        struct entry_t {
+            const void *owner;      // the GDBusSignal instance the handler belongs to; null if none
+            handler_t handler;
+            std::shared_ptr<owner_gate_t> gate;     // the gate of the owner; null if none
+        };
+        using handlers_t = std::vector<entry_t>;
+
+        struct subscription_t {
+            const obj_desc_t &sender;                   // interned
+            const std::string &member;                  // the signal name; interned
+            const std::string arg0;                     // the first argument to match, if has_arg0
+            const bool has_arg0;
+            unsigned id = 0;                            // the subscription id; 0 if not subscribed
+            metrics_t *const metrics;                   // the metrics of the sender and signal
+            const size_t sender_hash;                   // selects the dispatcher shard for ORDER_PER_SENDER
+            std::shared_ptr<const handlers_t> handlers = std::make_shared<handlers_t>();  // atomic_load/atomic_store only
+
+            subscription_t(const obj_desc_t &sender, const std::string &member, const char *arg0)
+                :   sender{ interned_t::object(sender) }, member{ interned_t::name(member) },
+                    arg0{ arg0 ? arg0 : "" }, has_arg0{ arg0 != nullptr },
+                    metrics{ metrics_t::instanceFor(sender, member) },
+                    sender_hash{ std::hash<std::string>{}(sender.name) }
+            {}
+        };
+
+        std::mutex signals_mutex;   // serializes the modifications of the registry; not used by dispatching
+        GDBusConnection *connection = nullptr;                              // the system bus, obtained on first use
+        using key_t = std::tuple<const obj_desc_t*, const std::string*, bool, std::string>;  // interned sender and member,
+                                                                                            //      has_arg0 and arg0
+        std::map<key_t, std::unique_ptr<subscription_t>> subscriptions;    // never removed: the callbacks refer to them
+        std::map<const void*, std::shared_ptr<owner_gate_t>> gates;         // the gates of the GDBusSignal instances subscribed
+
+        // Add the handler, installing the match rule if this is the first handler of the
+        // subscription. Returns false if the match rule cannot be installed.
+        bool add(const obj_desc_t &sender,
                  const std::string &signal_name,
-                 const gdbus_client::GDBusSignal::callback_t &callback)
+                 const char *arg0,
+                 const void *owner,
+                 const handler_t &handler)
         {
             std::lock_guard<std::mutex> lock{signals_mutex};
-            signal_map[key(sender.name, signal_name)].emplace_back(callback);
+            auto &sub = subscriptions[key(sender, signal_name, arg0)];
+            if (!sub) {
+                sub.reset(new subscription_t{ sender, signal_name, arg0 });
+            }
+            std::shared_ptr<owner_gate_t> gate;
+            if (owner) {
+                auto &g = gates[owner];
+                if (!g)
+                    g = std::make_shared<owner_gate_t>();
+                gate = g;
+            }
+            auto handlers = std::make_shared<handlers_t>(*std::atomic_load(&sub->handlers));
+            handlers->emplace_back(entry_t{ owner, handler, std::move(gate) });
+            std::atomic_store(&sub->handlers, std::shared_ptr<const handlers_t>{ std::move(handlers) });
+            return sub->id || subscribe(*sub);
         }
 
-        std::vector<gdbus_client::GDBusSignal::callback_t> get(
-                const std::string &sender_name,
-                const std::string &signal_name)
-        {
-            std::lock_guard<std::mutex> lock{signals_mutex};
-            return signal_map[key(sender_name, signal_name)];
+        // Remove all the handlers of the given GDBusSignal instance, and the match rules
+        // that have no handlers left. Waits until no handler of the instance is running,
+        // unless it is called from that handler.
+        void remove(const void *owner) {
+            std::shared_ptr<owner_gate_t> gate;
+            {
+                std::lock_guard<std::mutex> lock{signals_mutex};
+                const auto found = gates.find(owner);
+                if (found == gates.end())
+                    return;                             // never subscribed
+                gate = std::move(found->second);
+                gates.erase(found);
+                removeHandlers(owner);
+            }
+            std::lock_guard<std::recursive_mutex> lock{ gate->mutex };  // Outside of signals_mutex: a running
+            gate->removed = true;                                       //      handler might subscribe meanwhile
         }
 
+        static void onSignal(GDBusConnection *, const char *, const char *, const char *,
+                             const char *signal_name, GVariant *parameters, void *subscription);
+
+        // Invoke the handlers of the subscription, in the thread of the signal loop or of a
+        // dispatcher worker. The handlers of the same GDBusSignal instance never run
+        // concurrently, even if its subscriptions are dispatched by different workers.
+        static void dispatch(const void *subscription, const char *signal_name, GVariant *parameters) {
+            const auto &sub = *static_cast<const subscription_t*>(subscription);
+            const auto handlers = std::atomic_load(&sub.handlers);  // keeps the handlers alive
+            metrics_t::timer_t timer{ sub.metrics->dispatch };
+            for (const auto &entry: *handlers) {
+                if (!static_cast<bool>(entry.handler))
+                    continue;
+                if (!entry.gate) {
+                    entry.handler(sub.sender.name.c_str(), signal_name, parameters);
+                    continue;
+                }
+                std::lock_guard<std::recursive_mutex> lock{ entry.gate->mutex };
+                if (!entry.gate->removed)
+                    entry.handler(sub.sender.name.c_str(), signal_name, parameters);
+            }
+        }
+
+    private:
+        void removeHandlers(const void *owner) {    // called with signals_mutex locked
+            const auto by_owner = [owner](const entry_t &e) { return e.owner == owner; };
+            for (auto &entry: subscriptions) {
+                subscription_t &sub = *entry.second;
+                auto handlers = std::make_shared<handlers_t>(*std::atomic_load(&sub.handlers));
+                const auto removed = std::remove_if(handlers->begin(), handlers->end(), by_owner);
+                if (removed == handlers->end())
+                    continue;
+                handlers->erase(removed, handlers->end());
+                if (handlers->empty() && sub.id) {
+                    g_dbus_connection_signal_unsubscribe(connection, sub.id);
+                    sub.id = 0;
+                }
+                std::atomic_store(&sub.handlers, std::shared_ptr<const handlers_t>{ std::move(handlers) });
+            }
+        }
+
+        static key_t key(const obj_desc_t &sender, const std::string &signal_name, const char *arg0) {
+            return key_t{ &interned_t::object(sender), &interned_t::name(signal_name),
+                          arg0 != nullptr, arg0 ? arg0 : "" };
+        }
+
+        bool subscribe(subscription_t &sub) {   // called with signals_mutex locked
+            if (!connection) {
+                gerror_t err;
+                connection = g_bus_get_sync(G_BUS_TYPE_SYSTEM, nullptr, static_cast<GError**>(err));
+                if (!err.verboseCheckNoErr(AT()))
+                    return false;
+            }
+            gcontext_switcher_t gcontext_switcher{};    // The signals are dispatched in the thread-default context
+                                                        //      at the moment of subscribing; use the signal loop.
+            sub.id = g_dbus_connection_signal_subscribe(
+                    connection, sub.sender.name.c_str(), sub.sender.iface.c_str(),
+                    sub.member.c_str(), sub.sender.path.c_str(),
+                    sub.has_arg0 ? sub.arg0.c_str() : nullptr,
+                    G_DBUS_SIGNAL_FLAGS_NONE, onSignal, &sub, nullptr);
+            return logAssert(AT(), sub.id != 0, sub.sender.name + ": cannot subscribe to " + sub.member);
+        }
     }
     signals;
 
-    void onSignal(GDBusProxy *,
-                  const char *,
-                  const char *signal_name,
-                  GVariant   *,
-                  void * obj_name)
+
+    //  signal_dispatcher_t runs the signal handlers in a pool of worker threads, instead of
+    //  the thread of the signal loop, see setSignalDispatchThreads. Each worker owns a shard:
+    //  a queue of the signals to dispatch. The signals of the same sender (or subscription)
+    //  always go to the same shard, so they are dispatched in the order of arrival, while
+    //  a slow handler delays only the signals sharing its shard.
+    //
+    //  The queue is an intrusive multi-producer single-consumer list: pushing is a single
+    //  atomic exchange, and the worker pops without locking. The mutex and the condition
+    //  variable of the shard are only used to put the idle worker to sleep and wake it up.
+    struct signal_dispatcher_t {
+        using dispatch_t = void (*)(const void *subscription, const char *signal_name, GVariant *parameters);
+
+        struct event_t {
+            std::atomic<event_t*> next{ nullptr };
+            const void *subscription;
+            std::string signal_name;
+            GVariant *parameters;                       // referenced while queued
+        };
+
+        struct shard_t {
+            std::atomic<event_t*> head;                 // the last pushed event; pushed by any thread
+            event_t *tail;                              // the next event to pop; popped by the worker only
+            event_t stub;                               // keeps the list non-empty
+            std::atomic<bool> sleeping{ false };        // the worker waits for 'wakeup'
+            bool stopping = false;                      // guarded by mutex
+            std::mutex mutex;
+            std::condition_variable wakeup;
+            std::thread worker;
+
+            shard_t(): head{ &stub }, tail{ &stub } {}
+
+            void push(event_t *e) {
+                e->next.store(nullptr, std::memory_order_relaxed);
+                event_t *prev = head.exchange(e, std::memory_order_acq_rel);
+                prev->next.store(e, std::memory_order_release);
+            }
+
+            // Returns null if the queue is empty, or if a push is still in progress; the
+            // pushing thread then wakes the worker up, see post.
+            event_t* pop() {
+                event_t *t = tail;
+                event_t *next = t->next.load(std::memory_order_acquire);
+                if (t == &stub) {
+                    if (!next)
+                        return nullptr;
+                    tail = t = next;
+                    next = next->next.load(std::memory_order_acquire);
+                }
+                if (!next) {
+                    if (t != head.load(std::memory_order_acquire))
+                        return nullptr;
+                    push(&stub);
+                    next = t->next.load(std::memory_order_acquire);
+                    if (!next)
+                        return nullptr;
+                }
+                tail = next;
+                return t;
+            }
+
+            bool empty() const {                        // called by the worker only
+                return tail == &stub && !stub.next.load(std::memory_order_acquire);
+            }
+        };
+
+        const gdbus_client::GDBusSignalOrdering ordering;
+        const dispatch_t dispatch;
+        std::vector<std::unique_ptr<shard_t>> shards;
+
+        signal_dispatcher_t(unsigned threads, gdbus_client::GDBusSignalOrdering ordering, dispatch_t dispatch)
+            :   ordering{ ordering }, dispatch{ dispatch }
+        {
+            for (unsigned i = 0; i < threads; i++)
+                shards.emplace_back(new shard_t);
+            for (auto &shard: shards)
+                shard->worker = std::thread{ &signal_dispatcher_t::run, this, shard.get() };
+        }
+
+        // Dispatches the signals already queued, then stops the workers
+        ~signal_dispatcher_t() {
+            for (auto &shard: shards) {
+                std::lock_guard<std::mutex> lock{ shard->mutex };
+                shard->stopping = true;
+                shard->wakeup.notify_one();
+            }
+            for (auto &shard: shards)
+                shard->worker.join();
+        }
+
+        bool runsIn(std::thread::id id) const {
+            for (const auto &shard: shards)
+                if (shard->worker.get_id() == id)
+                    return true;
+            return false;
+        }
+
+        void post(const void *subscription, size_t sender_hash, const char *signal_name, GVariant *parameters) {
+            const size_t key = ordering == gdbus_client::ORDER_PER_SENDER ? sender_hash : std::hash<const void*>{}(subscription);
+            shard_t &shard = *shards[key % shards.size()];
+            shard.push(new event_t{ {}, subscription, signal_name, g_variant_ref(parameters) });
+            std::atomic_thread_fence(std::memory_order_seq_cst);   // pairs with the fence in run
+            if (shard.sleeping.load(std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> lock{ shard.mutex };
+                shard.wakeup.notify_one();
+            }
+        }
+
+    private:
+        void run(shard_t *shard) {
+            for (;;) {
+                if (event_t *e = shard->pop()) {
+                    dispatch(e->subscription, e->signal_name.c_str(), e->parameters);
+                    g_variant_unref(e->parameters);
+                    delete e;
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock{ shard->mutex };
+                shard->sleeping.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);   // pairs with the fence in post
+                if (shard->empty()) {
+                    if (shard->stopping)
+                        break;
+                    shard->wakeup.wait(lock);
+                }
+                shard->sleeping.store(false, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    std::shared_ptr<signal_dispatcher_t> signal_dispatcher;    // atomic_load/atomic_store only; null in the default mode
+
+    void signal_storage_t::onSignal(GDBusConnection *, const char *, const char *, const char *,
+                                    const char *signal_name, GVariant *parameters, void *subscription)
     {
-        const char *sender_name = reinterpret_cast<const char*>(obj_name);
-        auto callbacks = signals.get(sender_name, signal_name);
-        for (const auto &callback: callbacks) {
-            if (static_cast<bool>(callback)) {
-                callback(sender_name, signal_name);
+        const auto &sub = *static_cast<const subscription_t*>(subscription);
+        metrics_t::count(sub.metrics->signals);
+        if (const auto dispatcher = std::atomic_load(&signal_dispatcher))
+            dispatcher->post(subscription, sub.sender_hash, signal_name, parameters);
+        else
+            dispatch(subscription, signal_name, parameters);
+    }
+
+
+    // On the first invocation, create a new GLib context and event loop.
+    // On subsequent invocations, check whether the loop received an exit signal,
+    // and, if so, delete the context and the event loop and set their pointers
+    // to null. Return the current value of the event loop pointer.
+    GMainLoop* mainLoopInstance() {
+        static GMainContext *context = g_main_context_new();    // create the new g-context on the first invocation
+        static GMainLoop *loop = context?                       // create the new g-event-loop on the first invocation
+                g_main_loop_new(context, true):
+                nullptr;
+
+        if (context) {
+            g_main_context_unref(context);  // unref the context immediately; the loop holds another reference,
+            context = nullptr;              //    so it is not destoyed here
+        }
+
+        if (loop && !g_main_loop_is_running(loop)) {
+            g_main_loop_unref(loop);        // this also unrefs the main context, which is then destroyed
+            loop = nullptr;
+        }
+
+        return loop;
+    }
+
+    GMainContext* mainContextOf(GMainLoop *loop) {
+        return loop? g_main_loop_get_context(loop) : nullptr;
+    }
+
+    struct loop_timeout_t {
+        GSource *timeout = nullptr;
+        unsigned intervalMsec = 0;
+
+        // Set a timeout to wake up the main loop approximately after the given number of milliseconds
+        loop_timeout_t(unsigned interval_msec, GMainLoop *loop)  {
+            if (!loop) {
+                return;
+            }
+            intervalMsec = interval_msec;
+            if (intervalMsec != gdbus_client::WAIT_FOREVER) {
+                timeout = g_timeout_source_new(intervalMsec);
+                g_source_set_callback(timeout, noOpHandler, nullptr, nullptr);
+                g_source_attach(timeout, mainContextOf(loop));
+                g_source_unref(timeout); // one more reference is kept internally by the context,
+                                        //    therefore, the source is not destroyed here
             }
         }
+
+        ~loop_timeout_t() {
+            if (timeout) {
+                g_source_destroy(timeout);
+            }
+            timeout = nullptr;
+            intervalMsec = gdbus_client::WAIT_FOREVER;
+
+        }
+        static int noOpHandler(void *){ return G_SOURCE_CONTINUE; }
+    };
+
+
+    // g_context_switcher allows to temporary switch the GLib default thread context
+    gcontext_switcher_t::gcontext_switcher_t() {    // the constructor changes the current gcontext to the one (indirectly) returned from mainLoopInstance
+        context = mainContextOf(mainLoopInstance());
+        if (context) {
+            g_main_context_push_thread_default(context);
+        }
+    }
+    gcontext_switcher_t::gcontext_switcher_t(GMainContext *ctx) : context{ ctx } {
+        if (context) {
+            g_main_context_push_thread_default(context);
+        }
+    }
+    gcontext_switcher_t::~gcontext_switcher_t() {   // the destructor restores the current gcontext, if changed in constructor
+        if (context) {
+            g_main_context_pop_thread_default(context);
+        }
     }
 
 
-    // g_context_switcher allows to temporary change the GLib default thread context
-    struct gcontext_switcher_t {
-        GMainContext *context = nullptr;
-        gcontext_switcher_t(const gcontext_switcher_t &) = delete;
-        gcontext_switcher_t();  // the constructor changes the current gcontext to the one (indirectly) returned from mainLoopInstance
-        ~gcontext_switcher_t(); // the destructor restores the current gcontext, if changed in constructor
+    std::atomic<unsigned> signal_loop_users{ 0 };   // the number of threads inside waitAndProcessSignals, plus the
+                                                    //      external event loops driving it, see signal_poll_t
+
+    // The state of the signal loop driven by an external event loop of the thread, between
+    // prepareSignalPoll and dispatchSignals; the context is acquired and referenced meanwhile.
+    // The thread counts as a signal loop user from its first prepareSignalPoll until the
+    // signal loop is destroyed, or the thread exits.
+    struct signal_poll_t {
+        GMainContext *context = nullptr;            // non-null between the calls
+        int priority = 0;
+        std::vector<GPollFD> fds;
+        bool counted = false;                       // the thread is counted in signal_loop_users
+
+        void count(bool active) {
+            if (active != counted) {
+                counted = active;
+                active ? signal_loop_users++ : signal_loop_users--;
+            }
+        }
+
+        ~signal_poll_t() { count(false); }
     };
+    thread_local signal_poll_t signal_poll;
 
+    bool owner_watch_t::waitOwned(std::chrono::steady_clock::time_point until) {
+        std::unique_lock<std::mutex> lock{ mutex };
+        return changed.wait_until(lock, until, [this]{ return state.load() == OWNED; });
+    }
 
-    struct proxy_t {
-        GDBusProxy *proxy = nullptr;
-        std::string obj_name;
+    struct call_cleanup_guard_t {
+        call_t &call;
+        bool result = false;
 
-        proxy_t() = default;
-        proxy_t(const proxy_t&) = delete;
+        void setSuccess() { result = true; }
+        ~call_cleanup_guard_t() {
+            if (!result) {
+                for (const param_t &param: call.desc->params) { // Loop over the output params of the call
+                    if (param.cleanup)                          // Clean up out params;
+                        param.cleanup(call.valueOf(param));     //  'in' params have no cleanup
+                }
+            }
+        }
+    };
+
+    // Marshal the input params of the call into a tuple to be put into the D-Bus message.
+    // The tuple is adopted by 'holder', which keeps a reference to it and destroys it on
+    // its own destruction. The fds of TYPE_H params are collected into 'fds'. Returns null
+    // if any of the params fails to marshal.
+    GVariant* marshalInParams(call_t &call, variant_holder_t &holder, fd_list_t &fds) {
+        variant_holder_t &in_variants = call.in_variants;   // Loop over the input params and marshal them into in_variants
+        struct release_t {                                  // The tuple keeps its own references to the params
+            variant_holder_t &h;
+            fd_list_t &fds;
+            ~release_t() {
+                h.release();
+                std::swap(fds.list, gdbus_client::converters::outFdList());  // take over the fds marshalled,
+                g_clear_object(&gdbus_client::converters::outFdList());      //      if any
+            }
+        } release{ in_variants, fds };
+        g_clear_object(&gdbus_client::converters::outFdList());
+        metrics_t::timer_t timer{ call.desc->metrics->marshal };
+
+        for (const param_t &in_param: call.desc->params) {
+            if (in_param.marshal) {     // include 'in' parameters only
+                GVariant *in_variant = in_param.marshal(call.valueOf(in_param));
+                if (!in_param.verboseCheckMarshalled(AT(), in_variant) ||
+                    !in_variants.adopt(verboseNonNull(in_variant)))
+                    return nullptr;
+            }
+        }
+
+        GVariant *in_tuple = in_variants.to_tuple();
+        holder.adopt(in_tuple);         // Keep a reference to in_tuple, to have it properly destroyed with the holder.
+        return in_tuple;
+    }
+
+    // Check the type of the reply against the signature of the output params, with a single
+    // comparison of the type strings. The signature is built on the first use of the call
+    // description, when all the params are known. The reply may carry more values than there
+    // are output params, so only the prefix of the reply type is compared. If some output param
+    // has an indefinite type (TYPE_ATUP, TYPE_ANY), the check is skipped, and only the
+    // unmarshallers check their values.
+    bool verboseCheckReplyType(const call_t &call, GVariant *out_tuple) {
+        const std::string &expected = call.desc->reply_sig;
+        if (expected.empty())
+            return true;
+
+        const char *reply_sig = g_variant_get_type_string(out_tuple);
+        if (std::strncmp(reply_sig, expected.c_str(), expected.size()) == 0)
+            return true;
+        return logAssert(AT(), false, call.desc->method + ": unexpected reply type " + reply_sig +
+                                      ", expected " + expected + "...)");
+    }
+
+    // Unmarshal the reply tuple into the output params of the call. The fds of TYPE_H
+    // params are taken from 'fds', the fd list received with the reply.
+    bool unmarshalOutParams(call_t &call, GVariant *out_tuple, GUnixFDList *fds = nullptr) {
+        if (!verboseCheckReplyType(call, out_tuple))
+            return false;
+        metrics_t::timer_t timer{ call.desc->metrics->unmarshal };
+        struct in_fds_t {
+            explicit in_fds_t(GUnixFDList *fds) { gdbus_client::converters::inFdList() = fds; }
+            ~in_fds_t() { gdbus_client::converters::inFdList() = nullptr; }
+        } in_fds{ fds };
+
+        struct unmarshalled_t {     // On failure, discard the values this call has unmarshalled, e.g. close the fds
+            call_t &call;
+            size_t count = 0;       // the number of leading params unmarshalled
+            bool complete = false;
+            ~unmarshalled_t() {
+                for (size_t i = 0; !complete && i < count; i++) {
+                    const param_t &param = call.desc->params[i];
+                    if (param.discard)
+                        param.discard(call.valueOf(param));
+                }
+            }
+        } unmarshalled{ call };
+
+        // The reply type has matched reply_sig, so there is a child for each out param. Each
+        // child is still taken as a new reference: a child of a serialized container only
+        // exists as the GVariant GLib creates on access (there is no borrowed form), and the
+        // converters take a GVariant. Their own type checks, a comparison of the type strings,
+        // stay: dropping them would take an unchecked twin of each converter.
+        GVariantIter out_iter;
+        g_variant_iter_init(&out_iter, out_tuple);
+
+        for (const param_t &out_param: call.desc->params) { // Loop over the output params and unmarshal the response into them.
+            if (out_param.unmarshal) {    // include 'out' parameters only
+
+                GVariant *out_var = g_variant_iter_next_value(&out_iter);   // never null after verboseCheckReplyType
+                if (!verboseNonNull(out_var))
+                    return false;
+
+                const bool result = out_param.unmarshal(call.valueOf(out_param), out_var);
+                const bool ok = out_param.verboseCheckUnmarshalled( AT(), out_var, result );
+                g_variant_unref(out_var);
+                if (!ok)
+                    return false;
+            }
+            unmarshalled.count++;
+            // Possibly, add a check here that the reply has no more values,
+            //  but this will kill extensibility of the D-Bus API.
+        }
+        unmarshalled.complete = true;
+        return true;
+    }
+
+    // Get the proxy of the call target, counting the proxies replaced
+    proxy_t& proxyOf(call_t &call, const proxy_t::Policy policy) {
+        const proxy_t *previous = call.proxy_cache.proxy.get();
+        proxy_t &proxy = call.proxy_cache.get(call.desc->object, policy);
+        if (previous && previous != &proxy)
+            metrics_t::count(call.desc->metrics->proxy_recreations);
+        return proxy;
+    }
+
+    // The default call policy, replaced as a whole by GDBusCall::setDefaultPolicy.
+    // Accessed with atomic_load/atomic_store to avoid locking on each call.
+    std::shared_ptr<const gdbus_client::GDBusCallPolicy> default_policy =
+            std::make_shared<gdbus_client::GDBusCallPolicy>();
+
+
+    // retry_state_t applies GDBusCallPolicy to the successive attempts of a single call.
+    struct retry_state_t {
+        using clock = std::chrono::steady_clock;
+        using GDBusCallPolicy = gdbus_client::GDBusCallPolicy;
+
+        const GDBusCallPolicy policy;
+        const clock::time_point deadline;
+        unsigned attempts = 0;                      // the number of attempts made so far
+
+        explicit retry_state_t(const call_t &call)
+            :   policy{ call.has_policy ? call.policy : *std::atomic_load(&default_policy) },
+                deadline{ clock::now() + std::chrono::milliseconds{ std::max(policy.deadline_ms, 0) } }
+        {}
+
+        // The time limit of waiting for the owner of the target name with ABSENT_WAIT
+        clock::time_point ownerWaitLimit() const {
+            const int DEFAULT_TIMEOUT_MS = 25000;   // the default D-Bus timeout
+            return policy.deadline_ms >= 0 ? deadline :
+                    clock::now() + std::chrono::milliseconds{ policy.attempt_timeout_ms >= 0 ?
+                                                              policy.attempt_timeout_ms : DEFAULT_TIMEOUT_MS };
+        }
+
+        // Check whether the call is to be made now, given the state of the owner of the target
+        // name. Returns false if the call should fail. Waits for the owner with ABSENT_WAIT.
+        bool awaitOwner(owner_watch_t &owner) const {
+            if (owner.state.load() != owner_watch_t::VANISHED)
+                return true;            // the owner is there, or not yet known
+            switch (policy.if_absent) {
+                case GDBusCallPolicy::ABSENT_RETRY: return true;
+                case GDBusCallPolicy::ABSENT_FAIL:  return false;
+                case GDBusCallPolicy::ABSENT_WAIT:  return owner.waitOwned(ownerWaitLimit());
+            }
+            return true;
+        }
+
+        // With ABSENT_WAIT, the retry on SERVICE_UNKNOWN waits for the owner instead of the backoff,
+        // unless the watch is still unaware that the owner is gone.
+        bool waitsForOwner(const gerror_t &err, const owner_watch_t &owner) const {
+            return policy.if_absent == GDBusCallPolicy::ABSENT_WAIT &&
+                   err.errType() == gerror_t::SERVICE_UNKNOWN &&
+                   owner.state.load() == owner_watch_t::VANISHED;
+        }
+
+        proxy_t::Policy proxyPolicy() const {
+            return attempts == 0 ?
+                    proxy_t::USE_EXISTING:  // first encounter: use the pre-existing proxy, if possible
+                    proxy_t::RECREATE;      // on retry, recreate the proxy
+        }
 
-        proxy_t& operator=(proxy_t &&q) noexcept {
-            if (proxy != q.proxy) {         // This class maintains ownership of GDBusProxy * proxy;
-                g_clear_object(&proxy);     // thus the assignment operator transfers the ownership.
-                std::swap(proxy, q.proxy);  // The .proxy field of the original owner is cleared.
-                obj_name = std::move(q.obj_name);
-            }
-            return *this;
+        // The timeout of the next attempt in ms, as expected by g_dbus_proxy_call; -1 is the default.
+        int attemptTimeout() const {
+            if (policy.deadline_ms < 0)
+                return policy.attempt_timeout_ms;
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock::now()).count();
+            const int left_ms = static_cast<int>(std::max<decltype(left)>(left, 1));
+            return policy.attempt_timeout_ms < 0 ? left_ms : std::min(policy.attempt_timeout_ms, left_ms);
         }
 
-        explicit proxy_t(const obj_desc_t &obj) : obj_name(obj.name) {
-            gcontext_switcher_t gcontext_switcher{}; // Push the thread-default context to make sure that
-                                                     //     the callbacks of the proxy are dispatched in the
-                                                     //     thread that runs waitAndProcessSignals (see).
-                                                     // Also creates the custom main loop and context if they are not yet created.
-            gerror_t err;
-            proxy = g_dbus_proxy_new_for_bus_sync(                       // The proxy is created in the new thread-default context,
-                G_BUS_TYPE_SYSTEM, G_DBUS_PROXY_FLAGS_NONE, nullptr,     //    so the signal callbacks are dispatched in the context set by
-                obj.name.c_str(), obj.path.c_str(), obj.iface.c_str(),   //    the context switcher, which is the one bound to the main loop
-                nullptr, static_cast<GError**>(err));                    //    created in mainLoopInstance.
-                                                                         // Therefore, the callbacks are dispatched in the thread that calls
-            if (err.verboseCheckNoErr(AT())) {                           //     waitAndProcessSignals that iterates the main loop/context.
-                g_signal_connect(proxy,                                  // This way we avoid disturbing the application-default thread context,
-                                 "g-signal",                             //    that is sometimes abused by other libraries that use D-Bus to dispatch
-                                 G_CALLBACK(onSignal),                   //    their signals.
-                                 const_cast<char*>(obj_name.c_str()));
+        // Check whether the error is to be retried according to the policy. If so, 'wait'
+        // is set to the backoff before the next attempt.
+        bool shouldRetry(const gerror_t &err, std::chrono::milliseconds &wait) const {
+            static const std::map<gerror_t::errcode_t, unsigned> retryFlags {
+                { gerror_t::SERVICE_UNKNOWN,    GDBusCallPolicy::RETRY_SERVICE_UNKNOWN },
+                { gerror_t::SERVER_DISCONNECT,  GDBusCallPolicy::RETRY_SERVER_DISCONNECT },
+                { gerror_t::ACCESS_DENIED,      GDBusCallPolicy::RETRY_ACCESS_DENIED },
+                { gerror_t::TIMEOUT,            GDBusCallPolicy::RETRY_TIMEOUT },
+                { gerror_t::UNSPECIFIED,        GDBusCallPolicy::RETRY_UNSPECIFIED },
+            };
+            const auto flag = retryFlags.find(err.errType());
+            if (flag == retryFlags.end() || !(policy.retry_on & flag->second) ||
+                attempts >= std::max(policy.max_attempts, 1u))
+                return false;
+
+            double wait_ms = policy.backoff_ms;             // exponential backoff...
+            for (unsigned i = 1; i < attempts; i++)
+                wait_ms *= policy.backoff_factor;
+            if (policy.max_backoff_ms && wait_ms > policy.max_backoff_ms)
+                wait_ms = policy.max_backoff_ms;
+            if (policy.jitter_percent) {                    // ...with jitter
+                static thread_local std::minstd_rand random{ std::random_device{}() };
+                const double spread = std::min(policy.jitter_percent, 100u) / 100.0;
+                wait_ms *= std::uniform_real_distribution<double>{ 1.0 - spread, 1.0 + spread }(random);
             }
+            wait = std::chrono::milliseconds{ static_cast<long long>(std::max(wait_ms, 0.0)) };
+
+            return policy.deadline_ms < 0 ||                // do not retry if the wait would end past the deadline
+                   clock::now() + wait < deadline;
         }
+    };
 
-        bool verboseCheckNoErr(const char *func, unsigned line) const;
 
-        ~proxy_t() {
-            g_clear_object(&proxy); // proxy == null is ok here
+    // Run the given function in the thread that iterates waitAndProcessSignals.
+    // If the event loop is already destroyed (see stopProcessingSignals), there is no such
+    // thread, and the function is run immediately.
+    void runInSignalLoop(std::function<void()> &&func) {
+        GMainContext *context = mainContextOf(mainLoopInstance());
+        if (!context) {
+            func();
+            return;
         }
+        using func_t = std::function<void()>;
+        GSource *idle = g_idle_source_new();
+        g_source_set_callback(idle,
+                              [](void *f) { (*static_cast<func_t*>(f))(); return (int)G_SOURCE_REMOVE; },
+                              new func_t{ std::move(func) },
+                              [](void *f) { delete static_cast<func_t*>(f); });
+        g_source_attach(idle, context);
+        g_source_unref(idle);       // the context keeps its own reference until the source is dispatched
+    }
 
-        enum Policy { USE_EXISTING, RECREATE };
 
-        static proxy_t& instanceFor(const obj_desc_t &obj,  // Reentrant
-                                    const Policy policy)
+    // async_call_t is the state of a call made with GDBusCall::callAsync or GDBusBatch.
+    // It is created when the call is sent, lives while the D-Bus message is in flight
+    // (including the retries), and deletes itself after invoking the completion
+    // callback. The reply, the retries and the completion are all dispatched in the
+    // given GLib context: the one of the signal loop for callAsync, and a private
+    // one for GDBusBatch.
+    struct async_call_t {
+        std::shared_ptr<void> state;                // Keeps the call_t alive even if the GDBusCall is destroyed meanwhile
+        call_storage_t::call_guard_t call_guard;    // Owns the call until the reply is processed; the simultaneous use
+                                                    //      of the same GDBusCall is detected via its in-flight flag.
+        gdbus_client::GDBusCall::completion_t completion;
+        GMainContext *context;                      // The context to dispatch the reply in; a reference is kept.
+        variant_holder_t tuples;                    // Keeps a reference to the input tuple until the call is complete.
+        GVariant *in_tuple = nullptr;
+        fd_list_t in_fds;                           // The fds of the TYPE_H input params, if any
+        retry_state_t retry;
+        gerror_t err;
+        GSource *park_deadline = nullptr;           // the time limit of waiting for the owner with ABSENT_WAIT; referenced
+        std::chrono::steady_clock::time_point sent_at;     // the time the last attempt was sent
+
+        async_call_t(std::shared_ptr<void> state, call_storage_t::call_guard_t &&guard,
+                     const gdbus_client::GDBusCall::completion_t &completion,
+                     GMainContext *ctx)
+            :   state{ std::move(state) }, call_guard{ std::move(guard) }, completion{ completion },
+                context{ g_main_context_ref(ctx) }, retry{ *call_guard.call }
         {
-            static std::map<std::string, proxy_t> proxies;
-            static std::mutex proxy_mutex;
+            metrics_t::count(call_guard.call->desc->metrics->calls);
+        }
 
-            const std::string target =
-                    obj.name + " " + obj.path + " " + obj.iface;
+        ~async_call_t() {
+            g_main_context_unref(context);
+        }
 
-            std::lock_guard<std::mutex> lock{ proxy_mutex };
-            if (policy == Policy::RECREATE || !proxies[target].proxy) {
-                proxies[target] = proxy_t{obj};
+        // Send the D-Bus message; the reply is dispatched in 'context'.
+        void send() {
+            gcontext_switcher_t gcontext_switcher{ context };   // The reply callback is dispatched in the thread-default
+                                                                //      context at the moment of the call.
+            call_t &call = *call_guard.call;
+            owner_watch_t &owner = *call.proxy_cache.slotFor(call.desc->object).owner;
+            if (owner.state.load() == owner_watch_t::VANISHED &&
+                retry.policy.if_absent != gdbus_client::GDBusCallPolicy::ABSENT_RETRY)
+            {
+                if (retry.policy.if_absent == gdbus_client::GDBusCallPolicy::ABSENT_WAIT) {
+                    park();
+                    return;
+                }
+                logAssert(AT(), false, call.desc->object.name + ": the name has no owner on the bus");
+                complete(false);
+                return;
+            }
+            const proxy_t *previous = call.proxy_cache.proxy.get();
+            proxy_t *found = call.proxy_cache.peek(call.desc->object, retry.proxyPolicy());
+            if (!found) {                                       // Create the proxy without blocking the thread,
+                call.proxy_cache.slot->createAsync(             //      then send again
+                        call.proxy_cache.generation,
+                        [this](bool ready) { if (ready) send(); else complete(false); });
+                return;
+            }
+            if (previous && previous != found)
+                metrics_t::count(call.desc->metrics->proxy_recreations);
+            proxy_t &proxy = *found;
+            err.clear();
+            if (retry.attempts)
+                metrics_t::count(call.desc->metrics->retries);
+            sent_at = std::chrono::steady_clock::now();
+            if (call.desc->has_fds) {
+                g_dbus_proxy_call_with_unix_fd_list(
+                        proxy.proxy, call.desc->method.c_str(), in_tuple,
+                        G_DBUS_CALL_FLAGS_NONE, retry.attemptTimeout(), in_fds.list, nullptr,
+                        onReply, this);
             }
-            return proxies[target];
+            else {
+                g_dbus_proxy_call(
+                        proxy.proxy, call.desc->method.c_str(), in_tuple,
+                        G_DBUS_CALL_FLAGS_NONE, retry.attemptTimeout(), nullptr,
+                        onReply, this);
+            }
+            retry.attempts++;
         }
-    };
 
+        static void onReply(GObject *source, GAsyncResult *res, void *self) {
+            auto *async_call = static_cast<async_call_t*>(self);
+            async_call->onReply(reinterpret_cast<GDBusProxy*>(source), res);
+        }
 
-    struct variant_holder_t: public std::vector<GVariant *> {
-        bool adopt(GVariant *v) {
-            if (v)
-                push_back(g_variant_take_ref(v));
-            return static_cast<bool>(v);
+        void onReply(GDBusProxy *proxy, GAsyncResult *res) {
+            fd_list_t out_fds;
+            GVariant *out_tuple = call_guard.call->desc->has_fds ?
+                    g_dbus_proxy_call_with_unix_fd_list_finish(proxy, &out_fds.list, res, static_cast<GError**>(err)) :
+                    g_dbus_proxy_call_finish(proxy, res, static_cast<GError**>(err));
+            metrics_t &metrics = *call_guard.call->desc->metrics;
+            metrics.round_trip.add(std::chrono::steady_clock::now() - sent_at);
+            metrics.countError(err);
+
+            std::chrono::milliseconds wait;
+            if (!out_tuple && retry.shouldRetry(err, wait)) {
+                if (retry.waitsForOwner(err, *call_guard.call->proxy_cache.slot->owner)) {
+                    wait = std::chrono::milliseconds{ 0 };  // send() parks the call until the name has an owner
+                }
+                GSource *timeout = g_timeout_source_new(static_cast<unsigned>(wait.count()));    // wait before retrying;
+                                                                                                //      do not block the loop
+                g_source_set_callback(timeout, onSend, this, nullptr);
+                g_source_attach(timeout, context);
+                g_source_unref(timeout);
+                return;
+            }
+
+            variant_holder_t reply;         // Keep a reference to out_tuple to destroy it on return.
+            bool result = err.verboseCheckNoErr(AT()) && reply.adopt(verboseNonNull(out_tuple));
+            if (result) {
+                call_t &call = *call_guard.call;
+                std::lock_guard<std::mutex> lock{ call.instance_mutex };
+                result = !call.detached && unmarshalOutParams(call, out_tuple, out_fds.list);
+            }
+            complete(result);
         }
 
-        GVariant* to_tuple() {
-            return g_variant_new_tuple( empty()? nullptr : &front(), size() );
+        static int onSend(void *self) {
+            static_cast<async_call_t*>(self)->send();
+            return G_SOURCE_REMOVE;
         }
 
-        ~variant_holder_t() {
-            std::for_each(begin(), end(),
-                [](GVariant *v){ if (v) g_variant_unref(v);}) ;
+        // Send the message from 'context', so that the completion is dispatched there even
+        // if the call fails before anything is sent
+        void sendFromContext() {
+            GSource *idle = g_idle_source_new();
+            g_source_set_callback(idle, onSend, this, nullptr);
+            g_source_attach(idle, context);
+            g_source_unref(idle);
         }
 
-        static variant_holder_t from_tuple(GVariant *tuple) {
-            variant_holder_t vh;
-            for (unsigned i = 0; i < g_variant_n_children(tuple); i++)
-                vh.adopt(g_variant_get_child_value(tuple, i));
-            return vh;
+        // Wait for the owner of the target name, without blocking the thread: the owner watch
+        // resumes the call when the name gets an owner, and a timer fails it at the time limit.
+        // This costs no D-Bus traffic.
+        void park() {
+            using namespace std::chrono;
+            const auto left = duration_cast<milliseconds>(retry.ownerWaitLimit() - steady_clock::now());
+            park_deadline = g_timeout_source_new(static_cast<unsigned>(std::max(left.count(), milliseconds::rep{ 0 })));
+            g_source_set_callback(park_deadline, onParkDeadline, this, nullptr);
+            g_source_attach(park_deadline, context);
+            call_guard.call->proxy_cache.slot->owner->park({ context, onOwned, this });
         }
-    };
 
-    // On the first invocation, create a new GLib context and event loop.
-    // On subsequent invocations, check whether the loop received an exit signal,
-    // and, if so, delete the context and the event loop and set their pointers
-    // to null. Return the current value of the event loop pointer.
-    GMainLoop* mainLoopInstance() {
-        static GMainContext *context = g_main_context_new();    // create the new g-context on the first invocation
-        static GMainLoop *loop = context?                       // create the new g-event-loop on the first invocation
-                g_main_loop_new(context, true):
-                nullptr;
+        static int onOwned(void *self) {
+            auto *async_call = static_cast<async_call_t*>(self);
+            if (async_call->park_deadline) {
+                g_source_destroy(async_call->park_deadline);
+                g_source_unref(async_call->park_deadline);
+                async_call->park_deadline = nullptr;
+            }
+            async_call->send();
+            return G_SOURCE_REMOVE;
+        }
 
-        if (context) {
-            g_main_context_unref(context);  // unref the context immediately; the loop holds another reference,
-            context = nullptr;              //    so it is not destoyed here
+        static int onParkDeadline(void *self) {
+            auto *async_call = static_cast<async_call_t*>(self);
+            g_source_unref(async_call->park_deadline);
+            async_call->park_deadline = nullptr;
+            auto &owner = *async_call->call_guard.call->proxy_cache.slot->owner;
+            if (owner.unpark(async_call)) {         // otherwise onOwned is already scheduled, and sends the call
+                logAssert(AT(), false, owner.name + ": the name has no owner on the bus");
+                async_call->complete(false);
+            }
+            return G_SOURCE_REMOVE;
         }
 
-        if (loop && !g_main_loop_is_running(loop)) {
-            g_main_loop_unref(loop);        // this also unrefs the main context, which is then destroyed
-            loop = nullptr;
+        // Release the call before invoking the completion callback, so that the callback
+        // can reuse the same GDBusCall instance, e.g. to make the next call.
+        void complete(bool result) {
+            if (!result && call_guard.call) {
+                call_t &call = *call_guard.call;
+                metrics_t::count(call.desc->metrics->failures);
+                std::lock_guard<std::mutex> lock{ call.instance_mutex };
+                if (!call.detached)
+                    call_cleanup_guard_t{ call };           // Zero out the 'out' params of the call on failure
+            }
+            { auto released = std::move(call_guard); }
+            const auto on_complete = std::move(completion);
+            delete this;
+            if (on_complete) {
+                on_complete(result);
+            }
         }
+    };
 
-        return loop;
-    }
 
-    GMainContext* mainContextOf(GMainLoop *loop) {
-        return loop? g_main_loop_get_context(loop) : nullptr;
+    // Send the input tuple of the call without expecting a reply, see GDBusCall::callOneWay
+    bool sendOneWay(const proxy_t &proxy, const call_desc_t &d, GVariant *in_tuple, GUnixFDList *fds) {
+        GDBusMessage *message = g_dbus_message_new_method_call(
+                d.object.name.c_str(), d.object.path.c_str(), d.object.iface.c_str(), d.method.c_str());
+        unsigned flags = G_DBUS_MESSAGE_FLAGS_NO_REPLY_EXPECTED;
+        if (d.object.proxy_flags & gdbus_client::GDBusObjectDescriptor::PROXY_DO_NOT_AUTO_START)
+            flags |= G_DBUS_MESSAGE_FLAGS_NO_AUTO_START;
+        g_dbus_message_set_flags(message, static_cast<GDBusMessageFlags>(flags));
+        g_dbus_message_set_body(message, in_tuple);
+        if (fds)
+            g_dbus_message_set_unix_fd_list(message, fds);
+        gerror_t err;
+        g_dbus_connection_send_message(g_dbus_proxy_get_connection(proxy.proxy), message,
+                                       G_DBUS_SEND_MESSAGE_FLAGS_NONE, nullptr, static_cast<GError**>(err));
+        g_object_unref(message);
+        d.metrics->countError(err);
+        return err.verboseCheckNoErr(AT());
     }
 
-    struct loop_timeout_t {
-        GSource *timeout = nullptr;
-        unsigned intervalMsec = 0;
 
-        // Set a timeout to wake up the main loop approximately after the given number of milliseconds
-        loop_timeout_t(unsigned interval_msec, GMainLoop *loop)  {
-            if (!loop) {
-                return;
+    // coalescer_t merges the one-way calls of a target and method made within coalesce_ms
+    // after the last one sent: the newest input tuple replaces the pending one, and is sent
+    // by a timer in the signal loop. The instances are never destroyed, like metrics_t.
+    struct coalescer_t {
+        std::mutex mutex;                           // protects the members below
+        GVariant *pending = nullptr;                // the newest input tuple not sent yet; referenced
+        std::shared_ptr<proxy_t> proxy;             // the proxy to send 'pending' with
+        std::shared_ptr<call_desc_t> desc;          // the description of the call of 'pending'
+        int64_t quiet_until = 0;                    // the monotonic time (us) until which the calls are held
+        int64_t interval_us = 0;                    // coalesce_ms of the last call held
+        bool scheduled = false;                     // the timer sending 'pending' is armed
+
+        // Returns true if the tuple is held, to be sent by the timer; false if it is to be
+        // sent right away.
+        bool hold(const std::shared_ptr<call_desc_t> &d, const std::shared_ptr<proxy_t> &p,
+                  GVariant *in_tuple, unsigned coalesce_ms, GMainContext *context)
+        {
+            std::lock_guard<std::mutex> lock{ mutex };
+            const int64_t now = g_get_monotonic_time();
+            interval_us = static_cast<int64_t>(coalesce_ms) * 1000;
+            if (!scheduled && now >= quiet_until) {
+                quiet_until = now + interval_us;
+                return false;
             }
-            intervalMsec = interval_msec;
-            if (intervalMsec != gdbus_client::WAIT_FOREVER) {
-                timeout = g_timeout_source_new(intervalMsec);
-                g_source_set_callback(timeout, noOpHandler, nullptr, nullptr);
-                g_source_attach(timeout, mainContextOf(loop));
-                g_source_unref(timeout); // one more reference is kept internally by the context,
-                                        //    therefore, the source is not destroyed here
+            if (pending)
+                g_variant_unref(pending);           // superseded by the newer values
+            pending = g_variant_ref(in_tuple);
+            proxy = p;
+            desc = d;
+            if (!scheduled) {
+                scheduled = true;
+                GSource *timer = g_timeout_source_new(static_cast<unsigned>((quiet_until - now + 999) / 1000));
+                g_source_set_callback(timer, onTimer, this, nullptr);
+                g_source_attach(timer, context);
+                g_source_unref(timer);
             }
+            return true;
         }
 
-        ~loop_timeout_t() {
-            if (timeout) {
-                g_source_destroy(timeout);
+        static int onTimer(void *self) {
+            auto &c = *static_cast<coalescer_t*>(self);
+            std::lock_guard<std::mutex> lock{ c.mutex };
+            GVariant *in_tuple = c.pending;
+            const auto proxy = std::move(c.proxy);
+            const auto desc = std::move(c.desc);
+            c.pending = nullptr;
+            c.scheduled = false;
+            c.quiet_until = g_get_monotonic_time() + c.interval_us;    // hold the calls following this one, too
+            if (in_tuple) {                                             // sent under the mutex, see sendNow
+                if (!sendOneWay(*proxy, *desc, in_tuple, nullptr))
+                    metrics_t::count(desc->metrics->failures);
+                g_variant_unref(in_tuple);
             }
-            timeout = nullptr;
-            intervalMsec = gdbus_client::WAIT_FOREVER;
-
+            return G_SOURCE_REMOVE;
         }
-        static int noOpHandler(void *){ return G_SOURCE_CONTINUE; }
-    };
 
-
-    // g_context_switcher allows to temporary switch the GLib default thread context
-    gcontext_switcher_t::gcontext_switcher_t() {    // the constructor changes the current gcontext to the one (indirectly) returned from mainLoopInstance
-        context = mainContextOf(mainLoopInstance());
-        if (context) {
-            g_main_context_push_thread_default(context);
-        }
-    }
-    gcontext_switcher_t::~gcontext_switcher_t() {   // the destructor restores the current gcontext, if changed in constructor
-        if (context) {
-            g_main_context_pop_thread_default(context);
+        // Send the tuple right away, dropping the pending one it supersedes, so that the timer
+        // never sends older values after it. Both sends are made under the mutex, in order.
+        bool sendNow(const proxy_t &p, const call_desc_t &d, GVariant *in_tuple, GUnixFDList *fds) {
+            std::lock_guard<std::mutex> lock{ mutex };
+            if (pending) {
+                g_variant_unref(pending);
+                pending = nullptr;
+                proxy.reset();
+                desc.reset();
+            }
+            return sendOneWay(p, d, in_tuple, fds);
         }
-    }
-
-    struct call_cleanup_guard_t {
-        call_t &call;
-        bool result = false;
 
-        void setSuccess() { result = true; }
-        ~call_cleanup_guard_t() {
-            if (!result) {
-                for (param_t &param: call.params) { // Loop over the output params of the call
-                    param.cleanup();                // Clean up out params;
-                }                                   //  for 'in' params this does nothing
-            }
+        static coalescer_t& instanceFor(const call_desc_t &d) {     // Reentrant
+            static std::mutex coalescers_mutex;
+            static std::map<std::pair<const obj_desc_t*, const std::string*>, std::unique_ptr<coalescer_t>> coalescers;
+            std::lock_guard<std::mutex> lock{ coalescers_mutex };
+            auto &c = coalescers[{ &d.object, &d.method }];         // interned, so the same for all the instances of a type
+            if (!c)
+                c.reset(new coalescer_t);
+            return *c;
         }
     };
 }
@@ -549,21 +2351,30 @@ namespace {
 namespace gdbus_client {
 
     GDBusCall::GDBusCall(const GDBusObjectDescriptor &obj, const char *method) {
-        callUnderConstruction = this;
-        calls.add( this, call_t{ obj_desc_t::fromDesc(obj), method } );
+        callUnderConstruction = calls.add( this, nullptr, &obj, method );
     }
 
     GDBusCall::GDBusCall(const char *obj_name, const char *method) {
-        callUnderConstruction = this;
-        calls.add( this, call_t{ obj_desc_t::fromName(obj_name), method } );
+        callUnderConstruction = calls.add( this, obj_name, nullptr, method );
     }
 
     GDBusCall::~GDBusCall() {
-        calls.remove(this);
-        if (callUnderConstruction == this)
+        auto *state = static_cast<call_t*>(call.get());
+        if (state->in_flight.load()) {  // Too late to protect the params of the subclass; see cancelAsync
+            std::lock_guard<std::mutex> lock{ state->instance_mutex };
+            logAssert(AT(), state->detached, "A GDBusCall is destroyed while the call is in progress");
+            state->detached = true;
+        }
+        if (callUnderConstruction == call.get())
             callUnderConstruction = nullptr;
     }
 
+    void GDBusCall::cancelAsync() {
+        auto *state = static_cast<call_t*>(call.get());
+        std::lock_guard<std::mutex> lock{ state->instance_mutex };  // Waits for the reply being unmarshalled, if any
+        state->detached = true;
+    }
+
     bool GDBusCall::callSync() {    // Reentrant, although the values of out params of the call
                                     //      might be inconsistent.
         auto call_guard = calls.get(this);  // The call_guard is destroyed on return, unlocking the call data.
@@ -571,111 +2382,325 @@ namespace gdbus_client {
             return false;           // The error is already logged when executing calls.get().
 
         call_t &call = *call_guard.call;
+        metrics_t &metrics = *call.desc->metrics;
+        metrics_t::count(metrics.calls);
+        struct failure_counter_t {                      // Count the failure on any 'return false' below
+            metrics_t &metrics;
+            bool success = false;
+            ~failure_counter_t() { if (!success) metrics_t::count(metrics.failures); }
+        } failure_counter{ metrics };
 
         call_cleanup_guard_t cleanup_guard{ call };     // Zero out the 'out' params of the call on failure
 
-        variant_holder_t in_variants;   // Loop over the input params and marshal them into in_variants
-        for (const param_t &in_param: call.params) {
-            if (in_param.marshal) {     // include 'in' parameters only
-                GVariant *in_variant = in_param.marshal();
-                if (!in_param.verboseCheckMarshalled(AT(), in_variant) ||
-                    !in_variants.adopt(verboseNonNull(in_variant)))
-                    return false;
-            }
-        }
-
-        GVariant *in_tuple = in_variants.to_tuple();    // The tuple to be put into the D-Bus message
-
         variant_holder_t tuples;                        // 'tuples' is used as a hook to unreference and destroy on return the variants it has adopted.
-        tuples.adopt(in_tuple);                         // Keep a reference to in_tuple, to have it properly destroyed on return.
+        fd_list_t in_fds, out_fds;                      // The fd lists sent and received for TYPE_H params
+        GVariant *in_tuple = marshalInParams(call, tuples, in_fds); // The tuple to be put into the D-Bus message
+        if (!in_tuple)
+            return false;
 
         GVariant *out_tuple = nullptr;
         gerror_t err;
 
-        static const std::set<gerror_t::errcode_t> retriableErrors{
-                gerror_t::SERVICE_UNKNOWN,
-                gerror_t::SERVER_DISCONNECT
-        };
-
-        const int
-            MAX_ATTEMPTS = 3,   // try to make the call up to three times
-            WAIT_MS = 250;      // wait 250 ms before retrying
-        for (int attempts = MAX_ATTEMPTS; !out_tuple && attempts; attempts--) {
+        retry_state_t retry{ call };
+        owner_watch_t &owner = *call.proxy_cache.slotFor(call.desc->object).owner;
+        for (std::chrono::milliseconds wait;;) {
 
-            if (retriableErrors.count(err.errType())) {         // if we should retry on this type of error
-                std::this_thread::sleep_for(std::chrono::milliseconds{WAIT_MS});// sleep before retying
-            }
-            else if (err.errType() != gerror_t::NOERR) {        // in case of other errors bail out immediately and do not retry
-                break;
+            if (!logAssert(AT(), retry.awaitOwner(owner),
+                           call.desc->object.name + ": the name has no owner on the bus")) {
+                return false;
             }
-
-            const proxy_t::Policy proxy_policy = (attempts == MAX_ATTEMPTS ?
-                    proxy_t::USE_EXISTING:  // first encounter: use the pre-existing proxy, if possible
-                    proxy_t::RECREATE);     // on retry, recreate the proxy
-
-            proxy_t &proxy = proxy_t::instanceFor(call.object, proxy_policy);
+            proxy_t &proxy = proxyOf(call, retry.proxyPolicy());
             if (!proxy.verboseCheckNoErr(AT())) {
                 return false;
             }
             err.clear();
-            out_tuple = g_dbus_proxy_call_sync(
-                    proxy.proxy, call.method.c_str(), in_tuple,
-                    G_DBUS_CALL_FLAGS_NONE, -1, nullptr,
-                    (GError **) err);
+            if (retry.attempts)
+                metrics_t::count(metrics.retries);
+            {
+                metrics_t::timer_t timer{ metrics.round_trip };
+                out_tuple = call.desc->has_fds ?
+                        g_dbus_proxy_call_with_unix_fd_list_sync(
+                                proxy.proxy, call.desc->method.c_str(), in_tuple,
+                                G_DBUS_CALL_FLAGS_NONE, retry.attemptTimeout(), in_fds.list, &out_fds.list,
+                                nullptr, (GError **) err) :
+                        g_dbus_proxy_call_sync(
+                                proxy.proxy, call.desc->method.c_str(), in_tuple,
+                                G_DBUS_CALL_FLAGS_NONE, retry.attemptTimeout(), nullptr,
+                                (GError **) err);
+            }
+            metrics.countError(err);
+            retry.attempts++;
+
+            if (out_tuple || !retry.shouldRetry(err, wait)) {   // bail out on success, or on the errors not to be retried
+                break;
+            }
+            if (!retry.waitsForOwner(err, owner)) {             // awaitOwner waits for the owner instead;
+                std::this_thread::sleep_for(wait);              //      otherwise, sleep before retrying
+            }
         }
 
         if (!err.verboseCheckNoErr(AT()) ||
-            !tuples.adopt(verboseNonNull(out_tuple))) { // Keep a reference to out_tuple to destroy it on return.
-            return false;                               // out_tuple is NULL on error
+            !tuples.adopt(verboseNonNull(out_tuple)) || // Keep a reference to out_tuple to destroy it on return.
+            !unmarshalOutParams(call, out_tuple, out_fds.list)) {   // out_tuple is NULL on error
+            return false;
         }
+        cleanup_guard.setSuccess();
+        failure_counter.success = true;
+        return true;
+    }
 
-        variant_holder_t out_variants = variant_holder_t::from_tuple(out_tuple);
-        auto out_var_iter = out_variants.begin();
+    void GDBusCall::callAsync(const completion_t &completion) {
+        auto call_guard = calls.get(this);
+        GMainContext *context = mainContextOf(mainLoopInstance());
+        if (!call_guard.call || !context) { // The error is already logged when executing calls.get().
+            { auto released = std::move(call_guard); }
+            runInSignalLoop([completion]{ if (completion) completion(false); });
+            return;
+        }
 
-        for (param_t &out_param: call.params) { // Loop over the output params and unmarshal the response into them.
-            if (out_param.unmarshal) {    // include 'out' parameters only
+        auto *async_call = new async_call_t{ call, std::move(call_guard), completion, context };    // deletes itself on completion
+        async_call->in_tuple = marshalInParams(*async_call->call_guard.call, async_call->tuples, async_call->in_fds);
+        if (!async_call->in_tuple) {
+            runInSignalLoop([async_call]{ async_call->complete(false); });
+            return;
+        }
+        async_call->sendFromContext();
+    }
 
-                if (out_var_iter == out_variants.end() ||
-                    !verboseNonNull(*out_var_iter))
-                    return false;
+    bool GDBusCall::callOneWay() {
+        auto call_guard = calls.get(this);
+        if (!call_guard.call)
+            return false;
 
-                if ( !out_param.verboseCheckUnmarshalled( AT(),
-                    *out_var_iter, out_param.unmarshal(*out_var_iter) ) )
-                    return false;
+        call_t &call = *call_guard.call;
+        metrics_t &metrics = *call.desc->metrics;
+        metrics_t::count(metrics.calls);
+        const auto policy = call.has_policy ? call.policy : *std::atomic_load(&default_policy);
+
+        variant_holder_t tuples;
+        fd_list_t in_fds;
+        GVariant *in_tuple = marshalInParams(call, tuples, in_fds);
+        const auto &owner = *call.proxy_cache.slotFor(call.desc->object).owner;
+        bool sent = in_tuple &&
+                logAssert(AT(), owner.state.load() != owner_watch_t::VANISHED ||
+                                policy.if_absent == GDBusCallPolicy::ABSENT_RETRY,
+                          call.desc->object.name + ": the name has no owner on the bus");
+        proxy_t *proxy = sent ? &proxyOf(call, proxy_t::USE_EXISTING) : nullptr;
+        sent = sent && proxy->verboseCheckNoErr(AT());
+
+        if (sent && !call.coalescer)
+            call.coalescer = &coalescer_t::instanceFor(*call.desc);
+        GMainContext *context = mainContextOf(mainLoopInstance());
+        if (sent && policy.coalesce_ms && !call.desc->has_fds && context &&     // the fds are never coalesced;
+            signal_loop_users.load() &&                                         //      nor held with no thread to send them
+            call.coalescer->hold(call.desc, call.proxy_cache.proxy, in_tuple, policy.coalesce_ms, context))
+            return true;
+
+        sent = sent && call.coalescer->sendNow(*proxy, *call.desc, in_tuple, in_fds.list);  // supersedes the values held
+        if (!sent)
+            metrics_t::count(metrics.failures);
+        return sent;
+    }
+
+    std::future<bool> GDBusCall::callAsync() {
+        auto promise = std::make_shared<std::promise<bool>>();
+        callAsync([promise](bool success) { promise->set_value(success); });
+        return promise->get_future();
+    }
+
+
+    bool GDBusCall::setPolicy(const GDBusCallPolicy &policy) {
+        auto call_guard = calls.get(this);
+        if (!call_guard.call)
+            return false;
+        call_guard.call->policy = policy;
+        call_guard.call->has_policy = true;
+        return true;
+    }
+
+    void GDBusCall::setDefaultPolicy(const GDBusCallPolicy &policy) {
+        std::atomic_store(&default_policy,
+                          std::shared_ptr<const GDBusCallPolicy>{ std::make_shared<GDBusCallPolicy>(policy) });
+    }
+
+    void GDBusCall::setConnectionPool(unsigned n_connections) {
+        connection_pool.resize(n_connections);
+        std::vector<std::shared_ptr<proxy_slot_t>> dropped;     // the proxies on the closed connections
+        {
+            std::lock_guard<std::mutex> lock{ proxy_slot_t::slotsMutex() };
+            for (const auto &s: proxy_slot_t::slots())
+                if (s.second->connection > n_connections)
+                    dropped.push_back(s.second);
+        }
+        for (const auto &slot: dropped)
+            slot->invalidate();
+    }
+
+    void GDBusCall::setProxyCacheLimits(unsigned max_proxies, unsigned idle_msec) {
+        std::lock_guard<std::mutex> lock{ proxy_limits.mutex };
+        proxy_limits.max_proxies.store(max_proxies);
+        proxy_limits.idle_usec.store(static_cast<int64_t>(idle_msec) * 1000);
+        if (proxy_limits.sweeper) {
+            g_source_destroy(proxy_limits.sweeper);
+            g_source_unref(proxy_limits.sweeper);
+            proxy_limits.sweeper = nullptr;
+        }
+        GMainContext *context = mainContextOf(mainLoopInstance());
+        if (context && (idle_msec || max_proxies)) {
+            const unsigned period_ms = idle_msec ? std::min(std::max(idle_msec / 2, 100u), 10000u) : 1000u;
+            proxy_limits.sweeper = g_timeout_source_new(period_ms);
+            g_source_set_callback(proxy_limits.sweeper, proxy_limits_t::onSweep, &proxy_limits, nullptr);
+            g_source_attach(proxy_limits.sweeper, context);
+        }
+        proxy_limits.enforceMax();
+    }
+
+    void GDBusCall::prewarm(const char *obj_name) {
+        proxy_slot_t::instanceFor(obj_desc_t::fromName(obj_name),
+                                  connection_pool.connectionOfThisThread())->prewarm();
+    }
+
+    void GDBusCall::prewarm(const GDBusObjectDescriptor &desc) {
+        proxy_slot_t::instanceFor(obj_desc_t::fromDesc(desc),
+                                  connection_pool.connectionOfThisThread())->prewarm();
+    }
+
+    void GDBusCall::bindStructParam(GDBusStructParam *par, const char *param_name, bool in) {
+        param_t{ par, param_name, in }.moveIntoCall();
+    }
+
+    GDBusCallPolicy GDBusCall::defaultPolicy() {
+        return *std::atomic_load(&default_policy);
+    }
+
+
+    GDBusBatch::GDBusBatch(std::vector<GDBusCall*> calls) : calls{ std::move(calls) } {}
 
-                out_var_iter++;
+    std::vector<bool> GDBusBatch::callSync() {
+        std::vector<bool> results(calls.size(), false);
+
+        GMainContext *context = g_main_context_new();  // A private context to receive the replies in this thread only,
+        if (!verboseNonNull(context))                   //      without disturbing the signal loop.
+            return results;
+
+        size_t pending = 0;
+        {
+            // Marshal every call and send it before waiting for any reply. The same GDBusCall
+            // passed twice is detected by calls.get(), and its second copy fails.
+            std::vector<async_call_t*> batch;
+            for (size_t i = 0; i < calls.size(); i++) {
+                auto call_guard = calls[i] ? ::calls.get(calls[i]) :
+                                             call_storage_t::call_guard_t{};
+                if (!call_guard.call)
+                    continue;           // results[i] is false
+
+                auto *async_call = new async_call_t{ GDBusCallAccess::state(*calls[i]), std::move(call_guard),
+                        [&results, &pending, i](bool success) { results[i] = success; pending--; },
+                        context };      // deletes itself on completion
+                pending++;
+                async_call->in_tuple = marshalInParams(*async_call->call_guard.call, async_call->tuples,
+                                                       async_call->in_fds);
+                if (!async_call->in_tuple) {
+                    async_call->complete(false);
+                    continue;
+                }
+                batch.push_back(async_call);
+            }
+            for (async_call_t *async_call: batch) {
+                async_call->send();     // might complete immediately on error, decrementing 'pending'
             }
-            // Possibly, add a check here that out_var_iter reached out_variants.end(),
-            //  but this will kill extensibility of the D-Bus API.
         }
-        cleanup_guard.setSuccess();
-        return true;
+
+        while (pending) {
+            g_main_context_iteration(context, true);    // dispatch the replies and the retries; block if none
+        }
+        g_main_context_unref(context);
+        return results;
+    }
+
+
+    bool GDBusSignal::registerCallback(const char *sender_name,
+                                       const char *signal_name,
+                                       const GDBusSignal::callback_t &callback)
+    {
+        return registerCallback(sender_name, signal_name, nullptr, callback);
     }
 
+    bool GDBusSignal::registerCallback(const GDBusObjectDescriptor &desc,
+                                       const char *signal_name,
+                                       const GDBusSignal::callback_t &callback)
+    {
+        return registerCallback(desc, signal_name, nullptr, callback);
+    }
 
     bool GDBusSignal::registerCallback(const char *sender_name,
                                        const char *signal_name,
+                                       const char *arg0,
                                        const GDBusSignal::callback_t &callback)
     {
         const obj_desc_t sender = obj_desc_t::fromName(sender_name);
-        signals.add(sender, signal_name, callback);
-        proxy_t &proxy = proxy_t::instanceFor(sender, proxy_t::USE_EXISTING);
-        return proxy.verboseCheckNoErr(AT());
+        return signals.add(sender, signal_name, arg0, nullptr,
+                [callback](const char *sender, const char *signal, GVariant *) { if (callback) callback(sender, signal); });
     }
 
     bool GDBusSignal::registerCallback(const GDBusObjectDescriptor &desc,
                                        const char *signal_name,
+                                       const char *arg0,
                                        const GDBusSignal::callback_t &callback)
     {
         const obj_desc_t sender{desc.obj_name, desc.obj_path, desc.iface_name};
-        signals.add(sender, signal_name, callback);
-        proxy_t &proxy = proxy_t::instanceFor(sender, proxy_t::USE_EXISTING);
-        return proxy.verboseCheckNoErr(AT());
+        return signals.add(sender, signal_name, arg0, nullptr,
+                [callback](const char *sender, const char *signal, GVariant *) { if (callback) callback(sender, signal); });
+    }
+
+    GDBusSignal::GDBusSignal(const GDBusObjectDescriptor &desc, const char *signal_name) {
+        callUnderConstruction = calls.add( this, nullptr, &desc, signal_name );
+    }
+
+    GDBusSignal::GDBusSignal(const char *obj_name, const char *signal_name) {
+        callUnderConstruction = calls.add( this, obj_name, nullptr, signal_name );
+    }
+
+    GDBusSignal::~GDBusSignal() {
+        signals.remove(this);   // In case the subclass has not called unsubscribe; too late to protect its params
+        if (callUnderConstruction == call.get())
+            callUnderConstruction = nullptr;
+    }
+
+    void GDBusSignal::unsubscribe() {
+        signals.remove(this);
+    }
+
+    bool GDBusSignal::subscribe(const payload_callback_t &callback, const char *arg0) {
+        auto call_guard = calls.get(this);
+        if (!call_guard.call)
+            return false;
+        return signals.add(call_guard.call->desc->object, call_guard.call->desc->method, arg0, this,
+                [this, callback](const char *, const char *, GVariant *parameters) {
+                    {
+                        auto call_guard = calls.get(this);  // Detects the simultaneous use of this instance
+                        if (!call_guard.call)
+                            return;
+                        call_cleanup_guard_t cleanup_guard{ *call_guard.call };
+                        if (!logAssert(AT(), g_variant_is_of_type(parameters, G_VARIANT_TYPE_TUPLE),
+                                       call_guard.call->desc->method + ": the signal body is not a tuple") ||
+                            !unmarshalOutParams(*call_guard.call, parameters))
+                            return;
+                        cleanup_guard.setSuccess();
+                    }                                       // Release the instance before invoking the callback
+                    if (callback)
+                        callback();
+                });
     }
 
     bool waitAndProcessSignals(unsigned wait_msec) {
         using namespace std::chrono;
 
+        struct loop_user_t {                        // Count the threads iterating the signal loop,
+            loop_user_t()  { signal_loop_users++; } //      see signal_loop_users
+            ~loop_user_t() { signal_loop_users--; }
+        } loop_user;
+
         // wake up the main loop approx every (wait_msec) milliseconds
         loop_timeout_t timeout{ wait_msec, mainLoopInstance() };
 
@@ -692,6 +2717,141 @@ namespace gdbus_client {
         return mainLoopInstance() != nullptr;
     }
 
+    bool prepareSignalPoll(std::vector<GDBusPollFd> &fds, int &timeout_msec) {
+        static_assert(G_IO_IN == POLLIN && G_IO_OUT == POLLOUT && G_IO_PRI == POLLPRI &&
+                      G_IO_ERR == POLLERR && G_IO_HUP == POLLHUP, "GIOCondition differs from poll(2)");
+        fds.clear();
+        timeout_msec = -1;
+        GMainContext *context = mainContextOf(mainLoopInstance());
+        signal_poll.count(context != nullptr);
+        if (!logAssert(AT(), !signal_poll.context, "prepareSignalPoll called twice without dispatchSignals") ||
+            !context || !g_main_context_acquire(context))
+            return false;
+
+        signal_poll.context = g_main_context_ref(context);  // kept until dispatchSignals, even if the loop is destroyed
+        g_main_context_prepare(context, &signal_poll.priority);
+        signal_poll.fds.resize(std::max<size_t>(signal_poll.fds.size(), 4));
+        for (;;) {
+            const int n = g_main_context_query(context, signal_poll.priority, &timeout_msec,
+                                               signal_poll.fds.data(), static_cast<int>(signal_poll.fds.size()));
+            if (n <= static_cast<int>(signal_poll.fds.size())) {
+                signal_poll.fds.resize(n);
+                break;
+            }
+            signal_poll.fds.resize(n);                  // query again, with the room for all the fds
+        }
+        for (const GPollFD &p: signal_poll.fds)
+            fds.push_back(GDBusPollFd{ p.fd, static_cast<short>(p.events), 0 });
+        return true;
+    }
+
+    bool dispatchSignals(const std::vector<GDBusPollFd> &fds) {
+        GMainContext *context = signal_poll.context;
+        if (!logAssert(AT(), context && fds.size() == signal_poll.fds.size(),
+                       "dispatchSignals called without prepareSignalPoll"))
+            return mainLoopInstance() != nullptr;
+
+        for (size_t i = 0; i < fds.size(); i++)
+            signal_poll.fds[i].revents = static_cast<gushort>(fds[i].revents);
+        if (g_main_context_check(context, signal_poll.priority,
+                                 signal_poll.fds.data(), static_cast<int>(signal_poll.fds.size())))
+            g_main_context_dispatch(context);
+        signal_poll.context = nullptr;
+        g_main_context_release(context);
+        g_main_context_unref(context);
+        const bool running = mainLoopInstance() != nullptr;
+        signal_poll.count(running);
+        return running;
+    }
+
+    bool dispatchPending() {
+        GMainContext *context = mainContextOf(mainLoopInstance());
+        if (context && g_main_context_acquire(context)) {
+            while (g_main_context_iteration(context, false))    // dispatch what is ready; never block
+                ;
+            g_main_context_release(context);
+        }
+        return mainLoopInstance() != nullptr;
+    }
+
+    void setSignalDispatchThreads(unsigned threads, GDBusSignalOrdering ordering) {
+        static std::mutex dispatcher_mutex;
+        std::lock_guard<std::mutex> lock{ dispatcher_mutex };
+        auto previous = std::atomic_load(&signal_dispatcher);
+        if (!logAssert(AT(), !previous || !previous->runsIn(std::this_thread::get_id()),
+                       "cannot replace the signal dispatcher from a signal handler"))
+            return;
+        std::atomic_store(&signal_dispatcher, threads ?
+                std::make_shared<signal_dispatcher_t>(threads, ordering, &signal_storage_t::dispatch) :
+                std::shared_ptr<signal_dispatcher_t>{});
+        // The previous dispatcher is destroyed by the last onSignal still posting to it
+    }
+
+    GDBusCacheSizes cacheSizes() {
+        GDBusCacheSizes sizes;
+        std::vector<std::shared_ptr<proxy_slot_t>> slots;
+        {
+            std::lock_guard<std::mutex> lock{ proxy_slot_t::slotsMutex() };
+            for (const auto &s: proxy_slot_t::slots())
+                slots.push_back(s.second);
+        }
+        sizes.proxy_slots = slots.size();
+        sizes.proxies = proxy_t::alive().load();
+        {
+            std::lock_guard<std::mutex> lock{ owner_watch_t::watchesMutex() };
+            sizes.owner_watches = owner_watch_t::watches().size();
+        }
+        {
+            std::lock_guard<std::mutex> lock{ signals.signals_mutex };
+            for (const auto &s: signals.subscriptions)
+                sizes.signal_subscriptions += s.second->id ? 1 : 0;
+        }
+        {
+            std::lock_guard<std::mutex> lock{ interned_t::mutex() };
+            sizes.interned_objects = interned_t::objects().size();
+            sizes.interned_names = interned_t::names().size();
+        }
+        {
+            std::lock_guard<std::mutex> lock{ metrics_t::registryMutex() };
+            sizes.metrics = metrics_t::registry().size();
+        }
+        return sizes;
+    }
+
+    GDBusMetrics metricsSnapshot() {
+        GDBusMetrics snapshot;
+        std::lock_guard<std::mutex> lock{ metrics_t::registryMutex() };
+        snapshot.entries.resize(metrics_t::registry().size());
+        size_t i = 0;
+        for (const auto &m: metrics_t::registry())
+            m.second->copyTo(snapshot.entries[i++]);
+        return snapshot;
+    }
+
+    void setMetricsHook(unsigned period_ms, const metrics_hook_t &hook) {
+        static std::mutex hook_mutex;
+        static GSource *hook_source = nullptr;          // the timer invoking the current hook
+
+        std::lock_guard<std::mutex> lock{ hook_mutex };
+        if (hook_source) {
+            g_source_destroy(hook_source);              // destroys the previous hook, see below
+            g_source_unref(hook_source);
+            hook_source = nullptr;
+        }
+        GMainContext *context = mainContextOf(mainLoopInstance());
+        if (!period_ms || !hook || !context)
+            return;
+        hook_source = g_timeout_source_new(period_ms);
+        g_source_set_callback(hook_source,
+                              [](void *h) {
+                                  (*static_cast<metrics_hook_t*>(h))(metricsSnapshot());
+                                  return (int)G_SOURCE_CONTINUE;
+                              },
+                              new metrics_hook_t{ hook },
+                              [](void *h) { delete static_cast<metrics_hook_t*>(h); });
+        g_source_attach(hook_source, context);
+    }
+
     void stopProcessingSignals() {  // idempotent
         GMainLoop *loop = mainLoopInstance();
         if (loop) {
@@ -715,6 +2875,8 @@ namespace { // Error reporting section
                 "D-Bus: unknown D-Bus object name, check if server is up" },
             { errcode_t::SERVER_DISCONNECT,
                 "D-Bus: server disconnected in the middle of the call" },
+            { errcode_t::TIMEOUT,
+                "D-Bus: no reply in time, check the call policy and if server is not stuck" },
             { errcode_t::UNSPECIFIED,
                 "D-Bus: unspecified error" },
             { errcode_t::NOERR, "" },
@@ -727,7 +2889,7 @@ namespace { // Error reporting section
         return logAssert(func, line, false, message);
     }
 
-    bool call_t::verboseCheckNoErr(const char *func, unsigned line) {
+    bool call_desc_t::verboseCheckNoErr(const char *func, unsigned line) {
         bool good = true;
 
         good = logAssert( func, line,
@@ -753,35 +2915,24 @@ namespace { // Error reporting section
         return good;
     }
 
-    bool call_storage_t::call_guard_t::verboseCheckOwnership(   // Check that the use_count of the call pointer
-            unsigned n_owners, const char *func, unsigned line) //      is as expected.
-    {
-        const std::string call_info = call?
-                (call->object.iface + ":" + call->method) : "";
-
-        const unsigned n_users = (unsigned)call.use_count();
-        return logAssert( func, line,
-                n_users == n_owners || n_users == 0,
-                call_info + ": the call should have " + std::to_string(n_owners)
-                    + " users instead of " + std::to_string(call.use_count()));
-    }
-
-    bool call_storage_t::verboseStateCheck( const char *func,
-                                            const unsigned line)
-    {
-        return logAssert( func, line, !storage_destroyed,
-                "Detected access to GDBus Client after it was destroyed");
+    bool call_storage_t::verboseCheckNotInFlight(const char *func, unsigned line, call_t &call) {
+        if (!call.in_flight.exchange(true, std::memory_order_acquire))
+            return true;
+        return logAssert( func, line, false,
+                call.desc->object.iface + ":" + call.desc->method
+                    + ": the call is already in progress; simultaneous use of the same instance");
     }
 
     bool param_t::verboseCheckNoErr(const char *func, unsigned line,
                                     const void *gdbus_par,
-                                    const GDBusCall *call)
+                                    const call_t *call)
     {
         const char *err =  "Error initializing a D-Bus parameter: ";
-        static const unsigned MAX_CALL_BODY_SIZE = 4*1024;                  // The maximum size of the body of the GDBusCall descendant.
-
-        const bool par_in_call =    gdbus_par >= call &&                    // Check that the given GDBusParam<> lies
-                                    gdbus_par < call + MAX_CALL_BODY_SIZE;  // within the body of a Call instance. This is to warn about
+        static const unsigned MAX_CALL_BODY_SIZE = 32*1024;                 // The maximum size in bytes of the body of the GDBusCall
+                                                                            //      or GDBusSignal descendant.
+        const char *body = call ? call->base : nullptr;
+        const bool par_in_call =    gdbus_par >= body &&                    // Check that the given GDBusParam<> lies
+                                    gdbus_par < body + MAX_CALL_BODY_SIZE;  // within the body of a Call instance. This is to warn about
                                                                             // GDBusParam instances that are not class members of some GDBusCall
         return  logAssert( func, line, static_cast<bool>(call),             // Verify that the GDBusCall instance has been already constructed.
                            std::string(err) + "no Call instance")
@@ -813,6 +2964,62 @@ namespace { // Error reporting section
 }
 
 
+namespace gdbus_client {
+
+    template<typename Dbus_ParamType, typename ValueT>
+    GDBusProperty<Dbus_ParamType, ValueT>::GDBusProperty(const char *obj_name, const char *prop_name)
+        :   name{ prop_name }, cache{ std::make_shared<property_cache_t>(obj_desc_t::fromName(obj_name)) }
+    {}
+
+    template<typename Dbus_ParamType, typename ValueT>
+    GDBusProperty<Dbus_ParamType, ValueT>::GDBusProperty(const GDBusObjectDescriptor &desc, const char *prop_name)
+        :   name{ prop_name }, cache{ std::make_shared<property_cache_t>(obj_desc_t::fromDesc(desc)) }
+    {}
+
+    template<typename Dbus_ParamType, typename ValueT>
+    bool GDBusProperty<Dbus_ParamType, ValueT>::get(ValueT &value) const {
+        GVariant *v = static_cast<property_cache_t*>(cache.get())->cached(name.c_str());
+        if (!v)
+            return false;
+        // Check the exact type first, as verboseCheckReplyType does for the replies: the array
+        // and dict converters only check that the value is an array.
+        const char *expected = Dbus_ParamType().gType;
+        if (!logAssert(AT(), g_variant_is_of_type(v, G_VARIANT_TYPE(expected)),
+                       name + ": unexpected property type " + g_variant_get_type_string(v) + ", expected " + expected)) {
+            g_variant_unref(v);
+            return false;
+        }
+        ValueT fetched{};                           // leave 'value' untouched on a conversion failure
+        const bool res = converters::unmarshal(Dbus_ParamType(), v, fetched);
+        g_variant_unref(v);
+        if (res)
+            value = std::move(fetched);
+        return res;
+    }
+
+    // The GDBusProperty types declared in GDBusClient.hpp
+    template struct GDBusProperty<TYPE_S,     std::string>;
+    template struct GDBusProperty<TYPE_I,     int>;
+    template struct GDBusProperty<TYPE_U,     unsigned>;
+    template struct GDBusProperty<TYPE_Y,     unsigned char>;
+    template struct GDBusProperty<TYPE_N,     int16_t>;
+    template struct GDBusProperty<TYPE_T,     uint64_t>;
+    template struct GDBusProperty<TYPE_B,     bool>;
+    template struct GDBusProperty<TYPE_D,     double>;
+    template struct GDBusProperty<TYPE_O,     std::string>;
+    template struct GDBusProperty<TYPE_AS,    str_arr_t>;
+    template struct GDBusProperty<TYPE_AO,    str_arr_t>;
+    template struct GDBusProperty<TYPE_AY,    byte_arr_t>;
+    template struct GDBusProperty<TYPE_AI,    int_arr_t>;
+    template struct GDBusProperty<TYPE_AU,    uint_arr_t>;
+    template struct GDBusProperty<TYPE_AT,    uint64_arr_t>;
+    template struct GDBusProperty<TYPE_AD,    double_arr_t>;
+    template struct GDBusProperty<TYPE_DICT,  dict_t>;
+    template struct GDBusProperty<TYPE_VDICT, dict_t>;
+    template struct GDBusProperty<TYPE_VDICT, vdict_t>;
+}
+
+
 #define PARAM_CTOR(gtype, dir, value_type) \
     template<> GDBusCall::GDBusParam<gtype, dir, value_type> ::GDBusParam(const char *param_name, value_type v) \
     { param_t{ this, param_name, gdbus_type().gType, std::move(v) }.moveIntoCall(); }
@@ -842,14 +3049,31 @@ namespace gdbus_client {
     PARAM_CTOR(TYPE_O,      PARAM_OUT,  std::string);
     PARAM_CTOR(TYPE_V,      PARAM_IN,   std::string);
     PARAM_CTOR(TYPE_V,      PARAM_OUT,  std::string);
+    PARAM_CTOR(TYPE_H,      PARAM_IN,   int);
+    PARAM_CTOR(TYPE_H,      PARAM_OUT,  int);
     PARAM_CTOR(TYPE_AS,     PARAM_IN,   str_arr_t);
     PARAM_CTOR(TYPE_AS,     PARAM_OUT,  str_arr_t);
+    PARAM_CTOR(TYPE_AS,     PARAM_OUT,  as_view_t);
     PARAM_CTOR(TYPE_AO,     PARAM_IN,   str_arr_t);
     PARAM_CTOR(TYPE_AO,     PARAM_OUT,  str_arr_t);
+    PARAM_CTOR(TYPE_AO,     PARAM_OUT,  ao_view_t);
+    PARAM_CTOR(TYPE_AY,     PARAM_IN,   byte_arr_t);
+    PARAM_CTOR(TYPE_AY,     PARAM_OUT,  byte_arr_t);
+    PARAM_CTOR(TYPE_AI,     PARAM_IN,   int_arr_t);
+    PARAM_CTOR(TYPE_AI,     PARAM_OUT,  int_arr_t);
+    PARAM_CTOR(TYPE_AU,     PARAM_IN,   uint_arr_t);
+    PARAM_CTOR(TYPE_AU,     PARAM_OUT,  uint_arr_t);
+    PARAM_CTOR(TYPE_AT,     PARAM_IN,   uint64_arr_t);
+    PARAM_CTOR(TYPE_AT,     PARAM_OUT,  uint64_arr_t);
+    PARAM_CTOR(TYPE_AD,     PARAM_IN,   double_arr_t);
+    PARAM_CTOR(TYPE_AD,     PARAM_OUT,  double_arr_t);
     PARAM_CTOR(TYPE_DICT,   PARAM_IN,   dict_t);
     PARAM_CTOR(TYPE_DICT,   PARAM_OUT,  dict_t);
-    //     No (TYPE_VDICT,  PARAM_IN,   dict_t) constructor: not needed for anything interesting.
+    PARAM_CTOR(TYPE_DICT,   PARAM_OUT,  dict_view_t);
+    //     No (TYPE_VDICT,  PARAM_IN,   dict_t) constructor: the printed values cannot be sent back; see vdict_t.
     PARAM_CTOR(TYPE_VDICT,  PARAM_OUT,  dict_t);
+    PARAM_CTOR(TYPE_VDICT,  PARAM_IN,   vdict_t);
+    PARAM_CTOR(TYPE_VDICT,  PARAM_OUT,  vdict_t);
     //     No (TYPE_ATUP,   PARAM_IN,   tuple_arr_t) ctor: TYPE_ATUP is not a real D-Bus type, thus cannot send it.
     PARAM_CTOR(TYPE_ATUP,   PARAM_OUT,  tuple_arr_t); // Still, decoding an out parameter to this fake type is possible
     //     No (TYPE_ANY,    PARAM_IN,   std::string) ctor: TYPE_ANY is not a real D-Bus type, thus cannot send it.
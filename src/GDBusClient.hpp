@@ -24,7 +24,12 @@
 #include <functional>
 #include <map>
 #include <vector>
+#include <memory>
+#include <future>
+#include <utility>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 
 /* GDBusClient is a C++ wrapper around a subset of GLib g_dbus_ calls.
@@ -50,8 +55,14 @@ namespace gdbus_client {
         struct TYPE_D       { const char *gType = "d";      };      // D-Bus type 'd', a floating point value
         struct TYPE_O       { const char *gType = "o";      };      // D-Bus type 'o', an object path
         struct TYPE_V       { const char *gType = "v";      };      // D-Bus type 'v', a variant type; exact type unknown
+        struct TYPE_H       { const char *gType = "h";      };      // D-Bus type 'h', a Unix file descriptor
         struct TYPE_AS      { const char *gType = "as";     };      // D-Bus composite type 'as', an array of strings
         struct TYPE_AO      { const char *gType = "ao";     };      // D-Bus composite type 'ao', an array of object paths
+        struct TYPE_AY      { const char *gType = "ay";     };      // D-Bus composite type 'ay', an array of bytes
+        struct TYPE_AI      { const char *gType = "ai";     };      // D-Bus composite type 'ai', an array of 32-bit ints
+        struct TYPE_AU      { const char *gType = "au";     };      // D-Bus composite type 'au', an array of 32-bit unsigned ints
+        struct TYPE_AT      { const char *gType = "at";     };      // D-Bus composite type 'at', an array of 64-bit unsigned ints
+        struct TYPE_AD      { const char *gType = "ad";     };      // D-Bus composite type 'ad', an array of floating point values
         struct TYPE_DICT    { const char *gType = "a{ss}";  };      // D-Bus composite type 'a{ss}', an array of key-value (string-string) entities
         struct TYPE_VDICT   { const char *gType = "a{sv}";  };      // D-Bus composite type 'a{sv}', an array of variadic key-value (string-variant) entities
         struct TYPE_ATUP    { const char *gType = "a(*)";   };      // A synthetic type, an array of structs
@@ -69,7 +80,62 @@ namespace gdbus_client {
         const char *obj_name;       // The unique or well-known name, e.g. org.freedesktop.resolve1
         const char *obj_path;       // The D-Bus object path, e.g. /org/freedesktop/resolve1
         const char *iface_name;     // The interface name, e.g. org.freedesktop.resolve1.Manager
+
+        // How the proxy of the object is created; a bitmask of the values below. By default
+        // the proxy neither loads the properties of the interface nor tracks their changes,
+        // and a call to a name that is not on the bus auto-starts its service.
+        enum : unsigned {
+            PROXY_LOAD_PROPERTIES   = 1u << 0,  // Load the properties with GetAll, and track PropertiesChanged
+            PROXY_DO_NOT_AUTO_START = 1u << 1,  // Do not auto-start the service of the name on calls
+        };
+        unsigned proxy_flags = 0;
     };
+
+    // GDBusCallPolicy defines the time limits of a D-Bus call and how it is retried on errors.
+    // The policy is either set for a particular GDBusCall instance with setPolicy, or for all
+    // the calls that have no policy of their own, with GDBusCall::setDefaultPolicy.
+    //
+    // The default values reproduce the behaviour of the client before the policies were
+    // introduced: up to three attempts, 250 ms apart, each with the default D-Bus timeout.
+    struct GDBusCallPolicy {
+        int         attempt_timeout_ms  = -1;   // The timeout of each attempt; -1 is the D-Bus default (about 25 s)
+        int         deadline_ms         = -1;   // The time limit of the call including all the retries; -1 means no limit
+        unsigned    max_attempts        = 3;    // The number of attempts including the first one; 0 is treated as 1
+        unsigned    backoff_ms          = 250;  // The wait before the first retry
+        double      backoff_factor      = 1.0;  // The wait before each next retry is multiplied by this factor...
+        unsigned    max_backoff_ms      = 0;    // ...but is never longer than this, unless it is 0
+        unsigned    jitter_percent      = 0;    // Each wait is randomly spread by up to this percentage, either way
+
+        // The kinds of errors that are retried; a bitmask of the values below.
+        enum : unsigned {
+            RETRY_SERVICE_UNKNOWN   = 1u << 0,  // The target object name is not on the bus (yet)
+            RETRY_SERVER_DISCONNECT = 1u << 1,  // The server disconnected in the middle of the call
+            RETRY_ACCESS_DENIED     = 1u << 2,  // The call is not allowed by the bus policies
+            RETRY_TIMEOUT           = 1u << 3,  // No reply in attempt_timeout_ms
+            RETRY_UNSPECIFIED       = 1u << 4,  // Any other error, including the errors returned by the server
+        };
+        unsigned    retry_on            = RETRY_SERVICE_UNKNOWN | RETRY_SERVER_DISCONNECT;
+
+        // What to do when the target object name is known to have no owner on the bus, e.g.
+        // because the remote service is (re)starting. The owners of the names are tracked
+        // with g_bus_watch_name, see 'GDBusCall and D-Bus connection proxies' below.
+        enum Absent {
+            ABSENT_RETRY,   // Make the call anyway, and retry it as defined above
+            ABSENT_FAIL,    // Fail immediately, without sending anything
+            ABSENT_WAIT,    // Wait until the name gets an owner, then make the call; fail if that does not
+                            //      happen before deadline_ms, or attempt_timeout_ms if there is no deadline.
+                            //      The owner changes are only seen while a thread is iterating
+                            //      waitAndProcessSignals; otherwise the wait always times out.
+        };
+        Absent      if_absent           = ABSENT_RETRY;
+
+        // callOneWay only: after a call is sent, the calls of the same target and method made
+        // within this time are coalesced: only the newest input values are sent, at the end of
+        // the interval, by the thread iterating waitAndProcessSignals. The calls are only held
+        // while a thread is iterating it; otherwise each one is sent. 0 sends each call.
+        unsigned    coalesce_ms         = 0;
+    };
+
     /* -------- Overview --------
      *
      * GDBusCall and GDBusParam structs defined below are intended to define and make D-Bus calls.
@@ -106,6 +172,11 @@ namespace gdbus_client {
      *      of the supported holder types look at the list of GDBusParam constructors at the end of this
      *      header file.
      *
+     *      A TYPE_H param holds a Unix file descriptor, passed alongside the message rather than through
+     *      it, e.g. a memfd or a pipe to transfer bulk data. The descriptor of an input param is duplicated
+     *      into the message; the caller keeps its own one. The descriptor received in an output param is a
+     *      new one, owned and to be closed by the caller; it is -1 if the call fails.
+     *
      * 2. Instantiate the D-Bus call class.
      *
      *      static GetResourceIds getResourceIds;
@@ -128,8 +199,24 @@ namespace gdbus_client {
      *      If callSync() method returned true, the values of output params contain the D-Bus reply.
      *      The subsequent invocations of callSync will overwrite these data.
      *
+     * 5. Alternatively, make the call asynchronously.
+     *
+     *      getResourceIds.callAsync([](bool success) {
+     *          if (success)
+     *              std::cout << "Got " << getResourceIds.resourceIds.value.size() << " resource ids";
+     *      });
+     *
+     *      callAsync sends the D-Bus message and returns immediately. When the reply arrives, it is
+     *      de-serialized into the output params, and the completion callback is invoked. The callbacks
+     *      are dispatched in the thread that runs waitAndProcessSignals (see below), the same way as the
+     *      signal callbacks are; no replies are processed unless that function is being iterated.
+     *
+     *      Do not touch the params of the call until the completion callback is invoked.
+     *
      */
 
+    struct GDBusStructParam;
+
     // GDBusCall is used as a base class for concrete call implementations.
     // This struct should be inherited, and cannot be instantiated.
     struct GDBusCall {
@@ -147,6 +234,73 @@ namespace gdbus_client {
         // the call parameters.
         virtual bool callSync();
 
+        // callAsync makes the same D-Bus call as callSync, without waiting for the reply.
+        // The completion callback is invoked exactly once, with the same result callSync would
+        // return, and always in the thread iterating waitAndProcessSignals. If the call cannot
+        // be sent at all, e.g. because an input parameter fails to marshal, the callback still
+        // receives false in that thread. Neither the calling thread nor that one waits for the
+        // proxy of the target to be created. The only exception: after stopProcessingSignals,
+        // there is no such thread, and the callback receives false in the calling thread.
+        using completion_t = std::function<void(bool success)>;
+        void callAsync(const completion_t &completion);
+
+        // The same as above, but the result is delivered via std::future. Do not wait for
+        // the future in the thread iterating waitAndProcessSignals: it will never be ready.
+        std::future<bool> callAsync();
+
+        // cancelAsync detaches the callAsync in flight, if any, from the params of this
+        // instance: it waits while the reply is being unmarshalled, and then the reply is
+        // discarded and the completion receives false. A class that may be destroyed with a
+        // callAsync in flight must call it from its own destructor, before its params are
+        // destroyed; the instance must not be used afterwards.
+        void cancelAsync();
+
+        // callOneWay sends the call with NO_REPLY_EXPECTED, and returns as soon as the message
+        // is queued on the connection: no reply is awaited, the out params are not touched, and
+        // the call is not retried. Meant for the setters and notifications whose reply nobody
+        // reads. Returns false if the message cannot be sent, e.g. because an input parameter
+        // fails to marshal, or because the name has no owner, unless if_absent of the policy is
+        // ABSENT_RETRY; ABSENT_WAIT fails the same as ABSENT_FAIL. See also coalesce_ms.
+        bool callOneWay();
+
+        // setPolicy overrides the default call policy for this GDBusCall instance.
+        // Returns false if the call is in progress, and the policy is not changed.
+        bool setPolicy(const GDBusCallPolicy &policy);
+
+        // setDefaultPolicy sets the policy of all the calls that have no policy of their own.
+        // Reentrant; the calls in progress keep using the previous default.
+        static void setDefaultPolicy(const GDBusCallPolicy &policy);
+        static GDBusCallPolicy defaultPolicy();
+
+        // setConnectionPool makes the calls use n_connections private connections to the
+        // system bus instead of the one GLib shares with the rest of the process. Each thread
+        // is assigned one of them, round-robin, so that busy threads do not queue behind each
+        // other's messages and replies on the same connection. 0, the default, disables the
+        // pool. A change applies to the next call of each instance. Shrinking the pool closes
+        // the connections beyond n_connections: the calls in progress on them fail, or are
+        // retried as their policy says.
+        // The signals are always received on the shared connection.
+        static void setConnectionPool(unsigned n_connections);
+
+        // prewarm starts creating the proxy of the target asynchronously, ahead of the first
+        // call, so that the call does not wait for it. The proxy is ready once the thread
+        // iterating waitAndProcessSignals has dispatched the completion; a callSync or
+        // callOneWay made before that creates the proxy synchronously, as it would without
+        // prewarm, while callAsync never waits for it.
+        static void prewarm(const char *obj_name);
+        static void prewarm(const GDBusObjectDescriptor &desc);
+
+        // setProxyCacheLimits bounds the proxies kept for the targets called so far: those
+        // unused for idle_msec are dropped, and so are the least recently used ones above
+        // max_proxies. 0 disables the respective limit; both are 0 by default, and then the
+        // proxies are kept for as long as the process runs. The idle proxies are dropped by
+        // the thread iterating waitAndProcessSignals. A dropped proxy is created again by the
+        // next call of its target; an instance that has used the dropped proxy releases it on
+        // its own next call. The proxies of the GDBusProperty targets, which receive
+        // PropertiesChanged signals, are never dropped; the signals of GDBusSignal do not
+        // depend on the proxies.
+        static void setProxyCacheLimits(unsigned max_proxies, unsigned idle_msec);
+
         virtual ~GDBusCall();   // safe to inherit
 
     protected:                  // inherit only; do not create instances
@@ -158,17 +312,75 @@ namespace gdbus_client {
         // Provide GDBusObjectDescriptor if object name or path or interface name are
         // different from each over.
         GDBusCall(const GDBusObjectDescriptor &desc, const char *method);
+
+        GDBusCall(const GDBusCall&) = delete;               // the params are bound to the instance
+        GDBusCall& operator=(const GDBusCall&) = delete;
+
+    private:
+        friend struct GDBusCallAccess;
+        std::shared_ptr<void> call;     // the state of the call; opaque, see GDBusClient.cpp
+
+        // Bind the param of a mapped struct type to the call under construction, see GDBUS_STRUCT
+        static void bindStructParam(GDBusStructParam *par, const char *param_name, bool in);
+    };
+
+
+    // GDBusBatch makes several independent D-Bus calls at once: it marshals all of
+    // them, sends every message before waiting for any reply, and then unmarshals
+    // the replies into the output params of each call, the same way callSync does.
+    // The total time of a batch is thus about one D-Bus round-trip instead of one
+    // round-trip per call.
+    //
+    //      GetResourceIds getResourceIds;
+    //      GetStatus getStatus;
+    //      std::vector<bool> results = GDBusBatch{{ &getResourceIds, &getStatus }}.callSync();
+    //
+    // The calls must be valid until callSync returns; the rules of using the same
+    // GDBusCall instance from multiple threads apply to each of them. Passing the
+    // same instance twice in one batch is detected as a simultaneous use.
+    struct GDBusBatch {
+        std::vector<GDBusCall*> calls;
+
+        explicit GDBusBatch(std::vector<GDBusCall*> calls);
+
+        // Returns the results of the calls, in the same order as 'calls'. Each result
+        // is what callSync of the same call would return. Blocks until the last reply
+        // is received; the replies are processed in the calling thread.
+        std::vector<bool> callSync();
     };
 
 
     // GDBusSignal is used as a base class for concrete signal implementations.
     // This struct should be inherited, and cannot be instantiated.
+    //
+    // If the signal has a body, describe it the same way as the output params of a call,
+    // and subscribe an instance of the signal class to receive it:
+    //
+    //      struct PositionChanged: GDBusSignal
+    //      {
+    //          PositionChanged(): GDBusSignal("com.lgi.rdk.player", "PositionChanged") {}
+    //          ~PositionChanged() { unsubscribe(); }
+    //          GDBusParam<TYPE_S,  PARAM_OUT,  std::string>    sessionId   {"sessionId"};
+    //          GDBusParam<TYPE_T,  PARAM_OUT,  uint64_t>       position    {"position"};
+    //      };
+    //
+    //      static PositionChanged positionChanged;
+    //      positionChanged.subscribe([]{ std::cout << positionChanged.position.value; });
+    //
+    // Each time the signal is received, its body is unmarshalled into the params of the
+    // instance, then the callback is invoked. Both happen in the thread that iterates
+    // waitAndProcessSignals; do not access the params from other threads meanwhile. If
+    // the body does not match the params, the callback is not invoked. Only PARAM_OUT
+    // params are meaningful in a signal.
     struct GDBusSignal {
 
+        template<typename Dbus_ParamType, typename Dir, typename ValueT>
+        using GDBusParam = GDBusCall::GDBusParam<Dbus_ParamType, Dir, ValueT>;
+
         using callback_t = std::function<void(const char *sender_name,
                                               const char *signal_name)>;
 
-        // If tge signal does not have a body, just call one of registerCallback
+        // If the signal does not have a body, just call one of registerCallback
         // static member functions, providing the proper source and name of the
         // signal; there is no need to subclass GDBusSigbal.
         static bool registerCallback(const char *obj_name,
@@ -180,6 +392,87 @@ namespace gdbus_client {
         static bool registerCallback(const GDBusObjectDescriptor &desc,
                                      const char *signal_name,
                                      const callback_t &callback);
+
+        // The same as above, but only the signals with the first argument equal to
+        // the given string (e.g. the interface name in PropertiesChanged) are received.
+        static bool registerCallback(const char *obj_name,
+                                     const char *signal_name,
+                                     const char *arg0,
+                                     const callback_t &callback);
+        static bool registerCallback(const GDBusObjectDescriptor &desc,
+                                     const char *signal_name,
+                                     const char *arg0,
+                                     const callback_t &callback);
+
+        // Each distinct registration (object name, path, interface, signal name, and
+        // arg0 if given) installs a match rule on the bus, so only the signals that
+        // have been registered for are ever delivered to the process. The functions
+        // return false if the match rule cannot be installed.
+
+        // subscribe registers the callback invoked after the body of each received
+        // signal is unmarshalled into the params of this instance.
+        // If arg0 is given, only the signals with this first argument are received.
+        using payload_callback_t = std::function<void()>;
+        bool subscribe(const payload_callback_t &callback, const char *arg0 = nullptr);
+
+        // unsubscribe unregisters the callbacks of subscribe, and waits until none of them
+        // is running in another thread; then the params are no longer written. A class that
+        // subscribes must call it from its own destructor, before its params are destroyed,
+        // as in the example above: the destructor of GDBusSignal runs too late for that.
+        // It may also be called from the callback itself, and more than once.
+        void unsubscribe();
+
+        virtual ~GDBusSignal();     // safe to inherit
+
+    protected:                      // inherit only; do not create instances
+
+        // The same as the GDBusCall constructors, with the signal name instead of the method.
+        GDBusSignal(const char *obj_name, const char *signal_name);
+        GDBusSignal(const GDBusObjectDescriptor &desc, const char *signal_name);
+
+        GDBusSignal(const GDBusSignal&) = delete;           // the params are bound to the instance
+        GDBusSignal& operator=(const GDBusSignal&) = delete;
+
+    private:
+        friend struct GDBusCallAccess;
+        std::shared_ptr<void> call;     // the state of the signal; opaque, see GDBusClient.cpp
+    };
+
+
+    // GDBusProperty reads a property of a D-Bus object without a round-trip per read.
+    // The properties of the target are loaded with a single GetAll when the first
+    // GDBusProperty of the target is created, and then kept up to date by the
+    // PropertiesChanged signals, while a thread is iterating waitAndProcessSignals.
+    // A read is served from this cache, e.g.
+    //
+    //      GDBusProperty<TYPE_S, std::string> state{ {"org.freedesktop.login1",
+    //                                                 "/org/freedesktop/login1/seat/seat0",
+    //                                                 "org.freedesktop.login1.Seat"}, "State" };
+    //      std::string value;
+    //      if (state.get(value)) { ... }
+    //
+    // The types supported are the ones of the GDBusParam output params, except for the
+    // views and the synthetic types; see the list at the end of this file.
+    template<typename Dbus_ParamType, typename ValueT>
+    struct GDBusProperty {
+        // Provide GDBusObjectDescriptor if object name or path or interface name are
+        // different from each other (as in the example above)
+        GDBusProperty(const char *obj_name, const char *prop_name);
+        GDBusProperty(const GDBusObjectDescriptor &desc, const char *prop_name);
+
+        GDBusProperty(const GDBusProperty&) = delete;
+        GDBusProperty& operator=(const GDBusProperty&) = delete;
+
+        // get copies the cached value of the property into 'value'. Returns false, and
+        // leaves 'value' untouched, if the property is not cached, e.g. because the
+        // service is not on the bus, the properties are still being loaded, or the property
+        // has another type. get never blocks on D-Bus. The same instance may be read from
+        // several threads.
+        bool get(ValueT &value) const;
+
+    private:
+        std::string name;               // the property name
+        std::shared_ptr<void> cache;    // the handle to the cache; opaque, see GDBusClient.cpp
     };
 
 
@@ -216,6 +509,127 @@ namespace gdbus_client {
     // memory of the whole process anyway.
     void stopProcessingSignals();
 
+    // As an alternative to waitAndProcessSignals, the signal loop can be driven by the
+    // event loop of the application, e.g. one based on epoll, with no extra thread and no
+    // periodic wakeups. Each iteration of the application's loop then:
+    //
+    //      std::vector<GDBusPollFd> fds;
+    //      int timeout_msec;
+    //      if (prepareSignalPoll(fds, timeout_msec)) {
+    //          poll(...);              // wait for fds and timeout_msec, along with the
+    //                                  //      application's own fds; store the revents
+    //          dispatchSignals(fds);
+    //      }
+    //
+    // prepareSignalPoll returns the fds to wait for, with the poll(2) events, and the
+    // timeout (-1 for none); it returns false if the loop is stopped or is being iterated
+    // by another thread. dispatchSignals then dispatches whatever the revents have made
+    // ready, and returns false when the loop is stopped, like waitAndProcessSignals. The
+    // fds may change between the iterations; both calls must be made in the same thread,
+    // in pairs. From its first prepareSignalPoll until the loop stops (or the thread exits),
+    // the thread counts as iterating the signal loop, the same as one inside
+    // waitAndProcessSignals.
+    //
+    // dispatchPending dispatches the events that are ready without blocking, e.g. when the
+    // application's loop knows by other means that there is something to do. It returns
+    // false when the loop is stopped.
+    struct GDBusPollFd {
+        int fd;
+        short events;                   // POLLIN, POLLOUT, POLLPRI, POLLERR, POLLHUP, ...
+        short revents;
+    };
+    bool prepareSignalPoll(std::vector<GDBusPollFd> &fds, int &timeout_msec);
+    bool dispatchSignals(const std::vector<GDBusPollFd> &fds);
+    bool dispatchPending();
+
+    // setSignalDispatchThreads makes the signal handlers run in a pool of the given number
+    // of worker threads, instead of the thread iterating waitAndProcessSignals, so that a
+    // slow handler does not delay the signals of the other services. The signals are still
+    // received by waitAndProcessSignals, which must keep being iterated.
+    //
+    // The signals of the same sender (ORDER_PER_SENDER), or of the same subscription, i.e.
+    // the signal name, object and arg0 (ORDER_PER_SIGNAL), are dispatched by the same worker,
+    // in the order of arrival; there is no ordering between the others. Therefore the
+    // handlers of different GDBusSignal instances may run concurrently, and the values of
+    // a GDBusSignal instance are written in a worker thread. The handlers of the same
+    // instance never run concurrently, even with ORDER_PER_SIGNAL and several
+    // subscriptions; GDBusSignal::unsubscribe waits for its handler running.
+    //
+    // 0 threads, the default, dispatches the signals in the thread of waitAndProcessSignals.
+    // The signals queued in the previous pool are dispatched before it is replaced. Do not
+    // call this from a signal handler.
+    enum GDBusSignalOrdering {
+        ORDER_PER_SENDER,
+        ORDER_PER_SIGNAL
+    };
+    void setSignalDispatchThreads(unsigned threads, GDBusSignalOrdering ordering = ORDER_PER_SENDER);
+
+
+    // GDBusCacheSizes reports the sizes of the tables the client keeps, e.g. to check the
+    // effect of GDBusCall::setProxyCacheLimits on a long-running process
+    struct GDBusCacheSizes {
+        size_t proxy_slots = 0;                 // the targets in the proxy table
+        size_t proxies = 0;                     // the proxies alive, including the dropped ones still held by
+                                                //      the instances that called them, until their next call
+        size_t owner_watches = 0;               // the watched object names; never removed
+        size_t signal_subscriptions = 0;        // the match rules installed for the signals
+        size_t interned_objects = 0;            // the distinct targets; never removed
+        size_t interned_names = 0;              // the distinct method and signal names; never removed
+        size_t metrics = 0;                     // the entries of metricsSnapshot; never removed
+    };
+    GDBusCacheSizes cacheSizes();
+
+    // GDBusMetrics is a snapshot of the metrics the client keeps for each D-Bus target
+    // and method or signal name. The counters and histograms are updated on each call
+    // and each signal with a few relaxed atomic increments, so they are always on.
+    struct GDBusMetrics {
+        // The kinds of errors counted, the same as the retry kinds of GDBusCallPolicy
+        enum error_t {
+            ERROR_SERVICE_UNKNOWN,
+            ERROR_SERVER_DISCONNECT,
+            ERROR_ACCESS_DENIED,
+            ERROR_TIMEOUT,
+            ERROR_UNSPECIFIED,
+            ERROR_KINDS
+        };
+
+        // A latency histogram with power-of-two buckets: counts[0] is the number of samples
+        // shorter than 1 us, counts[i] of those in [2^(i-1), 2^i) us. The last bucket
+        // also counts all the longer samples.
+        struct histogram_t {
+            static const unsigned BUCKETS = 26;     // up to about 16 s
+            uint64_t counts[BUCKETS] = {};
+            uint64_t samples = 0;
+            uint64_t total_us = 0;
+        };
+
+        struct entry_t {
+            std::string obj_name, obj_path, iface_name;
+            std::string member;                     // the method or signal name
+            uint64_t calls = 0;                     // the calls made, sync or async
+            uint64_t failures = 0;                  // the calls that have failed
+            uint64_t retries = 0;                   // the attempts made after the first one
+            uint64_t proxy_recreations = 0;         // the proxies replaced for the calls
+            uint64_t errors[ERROR_KINDS] = {};      // the D-Bus errors of all the attempts, by kind
+            uint64_t signals = 0;                   // the signals dispatched
+            histogram_t marshal;                    // marshalling of the input params
+            histogram_t round_trip;                 // each attempt, from sending to the reply
+            histogram_t unmarshal;                  // unmarshalling of the reply or of the signal body
+            histogram_t dispatch;                   // invoking the handlers of a signal
+        };
+
+        std::vector<entry_t> entries;
+    };
+
+    // metricsSnapshot returns the current values of the metrics of all the targets used so far.
+    GDBusMetrics metricsSnapshot();
+
+    // setMetricsHook makes the hook receive metricsSnapshot() every period_ms, e.g. to
+    // forward it to a telemetry agent. The hook is invoked in the thread that runs
+    // waitAndProcessSignals. An empty hook, or period_ms == 0, removes the hook.
+    using metrics_hook_t = std::function<void(const GDBusMetrics &metrics)>;
+    void setMetricsHook(unsigned period_ms, const metrics_hook_t &hook);
+
 
     /* -------- Usage Details --------
      *
@@ -230,6 +644,16 @@ namespace gdbus_client {
      * If callSync succeeds in creating the object proxy but fails when calling it, the proxy is kept for
      * the next time.
      *
+     * The errors that are retried, and how many times, are defined by GDBusCallPolicy. Each retry
+     * recreates the proxy. When the policy has a deadline, no attempt lasts past the deadline, and
+     * no retry is made if its backoff would end past the deadline.
+     *
+     * The client watches the owners of the object names it has proxies for. When a name loses its
+     * owner, the proxies for it are dropped, and the next call creates a new one. The calls with the
+     * ABSENT_WAIT policy wait for the name to reappear instead of sleeping between the retries. The
+     * name owner changes are dispatched by waitAndProcessSignals, the same way as the signals are,
+     * so ABSENT_WAIT needs a thread iterating it; a waiting call never iterates the signal loop itself.
+     *
      * Multiple GDBusCall objects share, if possible, the same proxy and the same connection internally.
      *
      *
@@ -243,12 +667,20 @@ namespace gdbus_client {
      * detected by the GDBusCall class, and the subsequent call might fall.
      *
      * Avoid destroying GDBusCall when the call (made with the same class instance) is still in progress
-     * in another thread.
+     * in another thread. The same applies to callAsync: the call is in progress until its completion
+     * callback is invoked, and any other use of the same instance meanwhile is detected as simultaneous.
+     * Destroying an instance with a callAsync in flight is undefined, unless the destructor of the class
+     * that declares the params calls cancelAsync first; then the reply is discarded and the completion
+     * callback receives false. The callback itself must not refer to the destroyed instance.
      *
      * Therefore, if there are two threads that use the same GDBusCall child class, create the instances of
      * this class as automatic variables on stack, or, if they are class members or static variables, make
      * them thread_local. The last resort is to use an explicit synchronisation with a mutex.
      *
+     * Creating the instances is cheap: the description of the call (its target, method and params) is
+     * built by the first instance of a class in each thread and shared by the instances created later,
+     * without any global registration or locking. GDBusCall and GDBusSignal descendants are not copyable.
+     *
      *
      * -- Using std::move on the call parameters --
      *
@@ -262,12 +694,25 @@ namespace gdbus_client {
 
     // GDBusVariant is a wrapper on top of a const variant class, intended to hide
     // the implementation details of the variant. It is instantiated by some unmarshalling
-    // functions. GDBusVariant is copyable.
+    // functions. GDBusVariant is copyable and movable; a copy shares the same immutable
+    // variant, so copying is cheap and takes no locks.
     struct GDBusVariant {
-        GDBusVariant();
+        GDBusVariant() noexcept;
         GDBusVariant(const GDBusVariant&);
+        GDBusVariant(GDBusVariant&&) noexcept;
         ~GDBusVariant();
         GDBusVariant& operator=(const GDBusVariant &);
+        GDBusVariant& operator=(GDBusVariant &&) noexcept;
+
+        // Construct the variant holding the given value, e.g. to put it into vdict_t
+        explicit GDBusVariant(int32_t i);
+        explicit GDBusVariant(uint32_t u);
+        explicit GDBusVariant(int64_t x);
+        explicit GDBusVariant(uint64_t t);
+        explicit GDBusVariant(bool b);
+        explicit GDBusVariant(double d);
+        explicit GDBusVariant(const char *s);
+        explicit GDBusVariant(const std::string &s);
 
         // getT functions retrieve the contents of the variant. In case of success,
         // the result argument is set to true. In case of failure, it is set to false
@@ -277,9 +722,19 @@ namespace gdbus_client {
         double      getDouble(bool &result) const;
         std::string getString(bool &result) const;
         std::string getVariant(bool &result) const;     // for future use
+        uint32_t    getUint(bool &result) const;
+        int64_t     getInt64(bool &result) const;
+        uint64_t    getUint64(bool &result) const;
+
+        // return the D-Bus type of the contents, e.g. "u"; "" if the variant is empty
+        const char* type() const;
 
         // return the variant contents printed to a string
         std::string print() const;
+
+    private:
+        friend struct GDBusVariantAccess;
+        void *gv;       // the referenced GVariant, or nullptr if empty
     };
 
 
@@ -309,6 +764,8 @@ namespace gdbus_client {
     //              std::cout << tuple.name << "=" << tuple.value << std::endl;
     //              int value = tuple.value;
     //          }
+    //  Distinct tuple instances may be used in different threads simultaneously.
+    //
     //  For a practical example of GDBusTuple usage check
     //      onemw-src/av/sessionmanager/examples/testapp/sessionmgrTest.cpp
 
@@ -323,8 +780,20 @@ namespace gdbus_client {
         // Pretty-prints the contents of tuple
         std::string toString() const;
 
-        // field is a helper class; normally should not be instantiated
-        struct field { field(); field(const field&); ~field(); };
+        // field is a helper class; normally should not be instantiated.
+        // A field is bound to the tuple under construction and refers to its value
+        // by index; assigning a field does not rebind it.
+        struct field {
+            field(const field&);
+            ~field();
+            field& operator=(const field&);
+        protected:
+            explicit field(char type);
+            const GDBusVariant& value() const;
+        private:
+            const GDBusTuple *tuple;
+            unsigned index;
+        };
 
         // The ptype fields are wrappers for the int, double bool and string types,
         // used to represent D-Bus types i, f, b, s. Declare the members of type pint,
@@ -343,12 +812,248 @@ namespace gdbus_client {
     protected:
         GDBusTuple();   // Do not create instances of this class; inherit it instead
         ~GDBusTuple();
+    private:
+        // Each instance owns its values and the layout of its fields, so distinct
+        // tuples can be used in different threads, and reading a field is an index.
+        std::vector<GDBusVariant> vars;     // the values, in the order of the fields
+        std::string types;                  // the D-Bus type of each field, in the order of declaration
     };
 
 
+    // GDBusView is an opt-in holder type for output parameters of types TYPE_AS, TYPE_AO
+    // and TYPE_DICT. Instead of copying each string of the reply into std::string, it
+    // keeps a reference to the reply and exposes the C strings stored in the reply in place.
+    // The strings stay valid as long as the view (or a copy of it) holds them, i.e. until
+    // it is destroyed or receives the next reply. E.g.
+    //
+    //          GDBusParam<TYPE_AS,   PARAM_OUT, GDBusView<TYPE_AS>>    channels    {"channels"};
+    //          GDBusParam<TYPE_DICT, PARAM_OUT, GDBusView<TYPE_DICT>>  config      {"config"};
+    //      ...
+    //          for (const char *channel: call.channels.value) { ... }
+    //          const char *url = call.config.value.at("url");     // nullptr if absent
+    //
+    template<typename Item>
+    struct GDBusViewOf {
+        using value_type        = Item;
+        using const_iterator    = typename std::vector<Item>::const_iterator;
+
+        const_iterator  begin() const                   { return items.begin(); }
+        const_iterator  end() const                     { return items.end(); }
+        size_t          size() const                    { return items.size(); }
+        bool            empty() const                   { return items.empty(); }
+        const Item&     operator[](size_t i) const      { return items[i]; }
+
+        std::vector<Item> items;        // the pointers into the reply, in the order of the reply
+        GDBusVariant reply;             // keeps the strings referenced by items alive
+    };
+
+    template<typename Dbus_ParamType> struct GDBusView;
+
+    template<> struct GDBusView<GDBusType::TYPE_AS>:    GDBusViewOf<const char*> {};
+    template<> struct GDBusView<GDBusType::TYPE_AO>:    GDBusViewOf<const char*> {};
+    template<> struct GDBusView<GDBusType::TYPE_DICT>:  GDBusViewOf<std::pair<const char*, const char*>> {
+        // Return the value of the first entry with the given key, or nullptr. A linear search.
+        const char* at(const char *key) const {
+            for (const auto &e: items) {
+                if (std::strcmp(e.first, key) == 0)
+                    return e.second;
+            }
+            return nullptr;
+        }
+    };
+
+
+    // GDBUS_STRUCT maps a C++ struct to a D-Bus struct, field by field, so that the struct,
+    // or an array of such structs, is a GDBusParam of its own. E.g. to receive "a(si)":
+    //
+    //      struct Channel {
+    //          std::string name;
+    //          int32_t     number;
+    //      };
+    //      GDBUS_STRUCT(Channel, name, number)        // at the global scope
+    //
+    //      struct GetChannels: GDBusCall {
+    //          GetChannels(): GDBusCall("com.lgi.rdk.epg", "GetChannels") {}
+    //          GDBusParam<TYPE_ASTRUCT<Channel>, PARAM_OUT, std::vector<Channel>> channels {"channels"};
+    //      };
+    //
+    // The D-Bus type of each field follows from its C++ type: std::string is 's', int32_t 'i',
+    // uint32_t 'u', int16_t 'n', uint16_t 'q', uint8_t 'y', int64_t 'x', uint64_t 't', double 'd',
+    // bool 'b', and a struct mapped with GDBUS_STRUCT is a nested struct. The struct is
+    // encoded and decoded in a single typed pass over the fields, for in and out params.
+    // TYPE_STRUCT<Row> maps a single struct, TYPE_ASTRUCT<Row> an array of them.
+    template<typename Row> struct GDBusStructOf;    // specialized by GDBUS_STRUCT
+
+    struct GDBusStructLayout {
+        struct field_t {
+            char type;                              // the D-Bus type of the field, or '(' for a nested struct
+            const GDBusStructLayout *nested;        // the layout of the nested struct; null for the basic types
+            void* (*get)(void *row);                // the address of the field in the given row
+        };
+
+        std::string signature;                      // the D-Bus type of the struct, e.g. "(si)"
+        std::string array_signature;                // the D-Bus type of the array of the structs, e.g. "a(si)"
+        std::vector<field_t> fields;
+        size_t row_size;                            // sizeof(Row)
+
+        // The operations on the Row and std::vector<Row> holders of the params
+        void            (*reset)(void *row);
+        size_t          (*size)(const void *rows);
+        const void*     (*data)(const void *rows);
+        void*           (*resize)(void *rows, size_t n);
+
+        template<typename Row>
+        static GDBusStructLayout of(std::vector<field_t> fields) {
+            GDBusStructLayout l;
+            l.signature = "(";
+            for (const field_t &f: fields)
+                l.signature += f.nested ? f.nested->signature : std::string(1, f.type);
+            l.signature += ")";
+            l.array_signature = "a" + l.signature;
+            l.fields = std::move(fields);
+            l.row_size = sizeof(Row);
+            l.reset = [](void *row) { *static_cast<Row*>(row) = Row{}; };
+            l.size = [](const void *rows) { return static_cast<const std::vector<Row>*>(rows)->size(); };
+            l.data = [](const void *rows) -> const void* { return static_cast<const std::vector<Row>*>(rows)->data(); };
+            l.resize = [](void *rows, size_t n) -> void* {
+                auto &v = *static_cast<std::vector<Row>*>(rows);
+                v.resize(n);
+                return v.data();
+            };
+            return l;
+        }
+
+        template<typename Row, typename T, T Row::*Member>
+        static field_t field() {
+            static_assert(isBasic<T>::value || std::is_class<T>::value,
+                          "GDBUS_STRUCT: the field type has no D-Bus mapping; use one of the types listed "
+                          "above, or a struct mapped with GDBUS_STRUCT");
+            return field_t{ typeOf(static_cast<const T*>(nullptr)), nestedOf(static_cast<const T*>(nullptr)),
+                            [](void *row) -> void* { return &(static_cast<Row*>(row)->*Member); } };
+        }
+
+    private:
+        template<typename T>
+        struct isBasic: std::integral_constant<bool,    // T has a typeOf overload below
+                std::is_same<T, std::string>::value || std::is_same<T, int32_t>::value ||
+                std::is_same<T, uint32_t>::value    || std::is_same<T, int16_t>::value ||
+                std::is_same<T, uint16_t>::value    || std::is_same<T, uint8_t>::value ||
+                std::is_same<T, int64_t>::value     || std::is_same<T, uint64_t>::value ||
+                std::is_same<T, double>::value      || std::is_same<T, bool>::value> {};
+
+        static char typeOf(const std::string*)  { return 's'; }
+        static char typeOf(const int32_t*)      { return 'i'; }
+        static char typeOf(const uint32_t*)     { return 'u'; }
+        static char typeOf(const int16_t*)      { return 'n'; }
+        static char typeOf(const uint16_t*)     { return 'q'; }
+        static char typeOf(const uint8_t*)      { return 'y'; }
+        static char typeOf(const int64_t*)      { return 'x'; }
+        static char typeOf(const uint64_t*)     { return 't'; }
+        static char typeOf(const double*)       { return 'd'; }
+        static char typeOf(const bool*)         { return 'b'; }
+        template<typename T>
+        static char typeOf(const T*)            { return '('; }    // a nested struct, mapped with GDBUS_STRUCT
+
+        template<typename T>
+        static const GDBusStructLayout* nestedOf(const T*, typename std::enable_if<std::is_class<T>::value &&
+                                                     !std::is_same<T, std::string>::value>::type* = nullptr)
+        {
+            return &GDBusStructOf<T>::layout();
+        }
+        template<typename T>
+        static const GDBusStructLayout* nestedOf(const T*, typename std::enable_if<!std::is_class<T>::value ||
+                                                     std::is_same<T, std::string>::value>::type* = nullptr)
+        {
+            return nullptr;
+        }
+    };
+
+    namespace GDBusType {
+        template<typename Row> struct TYPE_STRUCT  { const char *gType = GDBusStructOf<Row>::layout().signature.c_str();       };
+        template<typename Row> struct TYPE_ASTRUCT { const char *gType = GDBusStructOf<Row>::layout().array_signature.c_str(); };
+    }
+
+    // GDBusStructParam is the part of the GDBusParam of a mapped struct seen by the converters
+    struct GDBusStructParam {
+        const GDBusStructLayout &layout;
+        const bool array;                           // the value is std::vector<Row>, not a Row
+        void* (*const value)(GDBusStructParam *par);// the address of the value of the param
+    };
+
+    template<typename Row, typename Dir>
+    struct GDBusCall::GDBusParam<GDBusType::TYPE_STRUCT<Row>, Dir, Row>: GDBusStructParam {
+        Row value = {};
+        explicit GDBusParam(const char *param_name, Row v = {})
+            :   GDBusStructParam{ GDBusStructOf<Row>::layout(), false,
+                                  [](GDBusStructParam *p) -> void* { return &static_cast<GDBusParam*>(p)->value; } },
+                value(std::move(v))
+        {
+            bindStructParam(this, param_name, std::is_same<Dir, GDBusDirection::PARAM_IN>::value);
+        }
+        using gdbus_type = GDBusType::TYPE_STRUCT<Row>;
+    };
+
+    template<typename Row, typename Dir>
+    struct GDBusCall::GDBusParam<GDBusType::TYPE_ASTRUCT<Row>, Dir, std::vector<Row>>: GDBusStructParam {
+        std::vector<Row> value;
+        explicit GDBusParam(const char *param_name, std::vector<Row> v = {})
+            :   GDBusStructParam{ GDBusStructOf<Row>::layout(), true,
+                                  [](GDBusStructParam *p) -> void* { return &static_cast<GDBusParam*>(p)->value; } },
+                value(std::move(v))
+        {
+            bindStructParam(this, param_name, std::is_same<Dir, GDBusDirection::PARAM_IN>::value);
+        }
+        using gdbus_type = GDBusType::TYPE_ASTRUCT<Row>;
+    };
+
+    #define GDBUS_STRUCT(Row, ...) \
+        namespace gdbus_client { \
+            template<> struct GDBusStructOf<Row> { \
+                static const GDBusStructLayout& layout() { \
+                    static const GDBusStructLayout l = GDBusStructLayout::of<Row>({ \
+                            GDBUS_STRUCT_FIELDS(Row, __VA_ARGS__) }); \
+                    return l; \
+                } \
+            }; \
+        }
+
+    // The helpers of GDBUS_STRUCT, for up to 16 fields
+    #define GDBUS_STRUCT_FIELD(Row, f)  gdbus_client::GDBusStructLayout::field<Row, decltype(Row::f), &Row::f>()
+    #define GDBUS_STRUCT_F1(R, f)       GDBUS_STRUCT_FIELD(R, f)
+    #define GDBUS_STRUCT_F2(R, f, ...)  GDBUS_STRUCT_FIELD(R, f), GDBUS_STRUCT_F1(R, __VA_ARGS__)
+    #define GDBUS_STRUCT_F3(R, f, ...)  GDBUS_STRUCT_FIELD(R, f), GDBUS_STRUCT_F2(R, __VA_ARGS__)
+    #define GDBUS_STRUCT_F4(R, f, ...)  GDBUS_STRUCT_FIELD(R, f), GDBUS_STRUCT_F3(R, __VA_ARGS__)
+    #define GDBUS_STRUCT_F5(R, f, ...)  GDBUS_STRUCT_FIELD(R, f), GDBUS_STRUCT_F4(R, __VA_ARGS__)
+    #define GDBUS_STRUCT_F6(R, f, ...)  GDBUS_STRUCT_FIELD(R, f), GDBUS_STRUCT_F5(R, __VA_ARGS__)
+    #define GDBUS_STRUCT_F7(R, f, ...)  GDBUS_STRUCT_FIELD(R, f), GDBUS_STRUCT_F6(R, __VA_ARGS__)
+    #define GDBUS_STRUCT_F8(R, f, ...)  GDBUS_STRUCT_FIELD(R, f), GDBUS_STRUCT_F7(R, __VA_ARGS__)
+    #define GDBUS_STRUCT_F9(R, f, ...)  GDBUS_STRUCT_FIELD(R, f), GDBUS_STRUCT_F8(R, __VA_ARGS__)
+    #define GDBUS_STRUCT_F10(R, f, ...) GDBUS_STRUCT_FIELD(R, f), GDBUS_STRUCT_F9(R, __VA_ARGS__)
+    #define GDBUS_STRUCT_F11(R, f, ...) GDBUS_STRUCT_FIELD(R, f), GDBUS_STRUCT_F10(R, __VA_ARGS__)
+    #define GDBUS_STRUCT_F12(R, f, ...) GDBUS_STRUCT_FIELD(R, f), GDBUS_STRUCT_F11(R, __VA_ARGS__)
+    #define GDBUS_STRUCT_F13(R, f, ...) GDBUS_STRUCT_FIELD(R, f), GDBUS_STRUCT_F12(R, __VA_ARGS__)
+    #define GDBUS_STRUCT_F14(R, f, ...) GDBUS_STRUCT_FIELD(R, f), GDBUS_STRUCT_F13(R, __VA_ARGS__)
+    #define GDBUS_STRUCT_F15(R, f, ...) GDBUS_STRUCT_FIELD(R, f), GDBUS_STRUCT_F14(R, __VA_ARGS__)
+    #define GDBUS_STRUCT_F16(R, f, ...) GDBUS_STRUCT_FIELD(R, f), GDBUS_STRUCT_F15(R, __VA_ARGS__)
+    #define GDBUS_STRUCT_NTH(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, N, ...) N
+    #define GDBUS_STRUCT_CAT(a, b)      GDBUS_STRUCT_CAT_(a, b)
+    #define GDBUS_STRUCT_CAT_(a, b)     a##b
+    #define GDBUS_STRUCT_FIELDS(R, ...) \
+        GDBUS_STRUCT_CAT(GDBUS_STRUCT_F, GDBUS_STRUCT_NTH(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1,))(R, __VA_ARGS__)
+
+
     using dict_t        = std::map<std::string, std::string>;
+    using vdict_t       = std::map<std::string, GDBusVariant>;     // a{sv}, with the values kept as they are
     using str_arr_t     = std::vector<std::string>;
+    using byte_arr_t    = std::vector<uint8_t>;     // the fixed-width arrays are copied as a whole
+    using int_arr_t     = std::vector<int32_t>;
+    using uint_arr_t    = std::vector<uint32_t>;
+    using uint64_arr_t  = std::vector<uint64_t>;
+    using double_arr_t  = std::vector<double>;
     using tuple_arr_t   = std::vector<std::vector<GDBusVariant>>;
+    using as_view_t     = GDBusView<GDBusType::TYPE_AS>;
+    using ao_view_t     = GDBusView<GDBusType::TYPE_AO>;
+    using dict_view_t   = GDBusView<GDBusType::TYPE_DICT>;
     using namespace GDBusDirection;
     using namespace GDBusType;
 
@@ -374,19 +1079,58 @@ namespace gdbus_client {
     template<> GDBusCall::GDBusParam<TYPE_O,    PARAM_OUT,  std::string>    ::GDBusParam(const char*, std::string);
     template<> GDBusCall::GDBusParam<TYPE_V,    PARAM_IN,   std::string>    ::GDBusParam(const char*, std::string);
     template<> GDBusCall::GDBusParam<TYPE_V,    PARAM_OUT,  std::string>    ::GDBusParam(const char*, std::string);
+    template<> GDBusCall::GDBusParam<TYPE_H,    PARAM_IN,   int>            ::GDBusParam(const char*, int);
+    template<> GDBusCall::GDBusParam<TYPE_H,    PARAM_OUT,  int>            ::GDBusParam(const char*, int);
     template<> GDBusCall::GDBusParam<TYPE_AS,   PARAM_IN,   str_arr_t>      ::GDBusParam(const char*, str_arr_t);
     template<> GDBusCall::GDBusParam<TYPE_AS,   PARAM_OUT,  str_arr_t>      ::GDBusParam(const char*, str_arr_t);
+    template<> GDBusCall::GDBusParam<TYPE_AS,   PARAM_OUT,  as_view_t>      ::GDBusParam(const char*, as_view_t);
     template<> GDBusCall::GDBusParam<TYPE_AO,   PARAM_IN,   str_arr_t>      ::GDBusParam(const char*, str_arr_t);
     template<> GDBusCall::GDBusParam<TYPE_AO,   PARAM_OUT,  str_arr_t>      ::GDBusParam(const char*, str_arr_t);
+    template<> GDBusCall::GDBusParam<TYPE_AO,   PARAM_OUT,  ao_view_t>      ::GDBusParam(const char*, ao_view_t);
+    template<> GDBusCall::GDBusParam<TYPE_AY,   PARAM_IN,   byte_arr_t>     ::GDBusParam(const char*, byte_arr_t);
+    template<> GDBusCall::GDBusParam<TYPE_AY,   PARAM_OUT,  byte_arr_t>     ::GDBusParam(const char*, byte_arr_t);
+    template<> GDBusCall::GDBusParam<TYPE_AI,   PARAM_IN,   int_arr_t>      ::GDBusParam(const char*, int_arr_t);
+    template<> GDBusCall::GDBusParam<TYPE_AI,   PARAM_OUT,  int_arr_t>      ::GDBusParam(const char*, int_arr_t);
+    template<> GDBusCall::GDBusParam<TYPE_AU,   PARAM_IN,   uint_arr_t>     ::GDBusParam(const char*, uint_arr_t);
+    template<> GDBusCall::GDBusParam<TYPE_AU,   PARAM_OUT,  uint_arr_t>     ::GDBusParam(const char*, uint_arr_t);
+    template<> GDBusCall::GDBusParam<TYPE_AT,   PARAM_IN,   uint64_arr_t>   ::GDBusParam(const char*, uint64_arr_t);
+    template<> GDBusCall::GDBusParam<TYPE_AT,   PARAM_OUT,  uint64_arr_t>   ::GDBusParam(const char*, uint64_arr_t);
+    template<> GDBusCall::GDBusParam<TYPE_AD,   PARAM_IN,   double_arr_t>   ::GDBusParam(const char*, double_arr_t);
+    template<> GDBusCall::GDBusParam<TYPE_AD,   PARAM_OUT,  double_arr_t>   ::GDBusParam(const char*, double_arr_t);
     template<> GDBusCall::GDBusParam<TYPE_DICT, PARAM_IN,   dict_t>         ::GDBusParam(const char*, dict_t);
     template<> GDBusCall::GDBusParam<TYPE_DICT, PARAM_OUT,  dict_t>         ::GDBusParam(const char*, dict_t);
-    // No spec here for  (GDBusParam<TYPE_VDICT,PARAM_IN,   dict_t>): not implemented as an input parameter
+    template<> GDBusCall::GDBusParam<TYPE_DICT, PARAM_OUT,  dict_view_t>    ::GDBusParam(const char*, dict_view_t);
+    // No spec here for  (GDBusParam<TYPE_VDICT,PARAM_IN,   dict_t>): the printed values cannot be sent back; use vdict_t
     template<> GDBusCall::GDBusParam<TYPE_VDICT,PARAM_OUT,  dict_t>         ::GDBusParam(const char*, dict_t);
+    template<> GDBusCall::GDBusParam<TYPE_VDICT,PARAM_IN,   vdict_t>        ::GDBusParam(const char*, vdict_t);
+    template<> GDBusCall::GDBusParam<TYPE_VDICT,PARAM_OUT,  vdict_t>        ::GDBusParam(const char*, vdict_t);
     // No spec here for  (GDBusParam<TYPE_ATUP, PARAM_IN,   tuple_arr_t>): TYPE_ATUP is not a real DBUS type; cannot be an input param
     template<> GDBusCall::GDBusParam<TYPE_ATUP, PARAM_OUT,  tuple_arr_t>    ::GDBusParam(const char*, tuple_arr_t);
     // No spec here for  (GDBusParam<TYPE_ANY, PARAM_IN,   tuple_arr_t>): TYPE_ANY is not a real DBUS type; cannot be an input param
     template<> GDBusCall::GDBusParam<TYPE_ANY,  PARAM_OUT,  std::string>    ::GDBusParam(const char*, std::string);
 
+    /* The GDBusProperty types */
+
+    extern template struct GDBusProperty<TYPE_S,     std::string>;
+    extern template struct GDBusProperty<TYPE_I,     int>;
+    extern template struct GDBusProperty<TYPE_U,     unsigned>;
+    extern template struct GDBusProperty<TYPE_Y,     unsigned char>;
+    extern template struct GDBusProperty<TYPE_N,     int16_t>;
+    extern template struct GDBusProperty<TYPE_T,     uint64_t>;
+    extern template struct GDBusProperty<TYPE_B,     bool>;
+    extern template struct GDBusProperty<TYPE_D,     double>;
+    extern template struct GDBusProperty<TYPE_O,     std::string>;
+    extern template struct GDBusProperty<TYPE_AS,    str_arr_t>;
+    extern template struct GDBusProperty<TYPE_AO,    str_arr_t>;
+    extern template struct GDBusProperty<TYPE_AY,    byte_arr_t>;
+    extern template struct GDBusProperty<TYPE_AI,    int_arr_t>;
+    extern template struct GDBusProperty<TYPE_AU,    uint_arr_t>;
+    extern template struct GDBusProperty<TYPE_AT,    uint64_arr_t>;
+    extern template struct GDBusProperty<TYPE_AD,    double_arr_t>;
+    extern template struct GDBusProperty<TYPE_DICT,  dict_t>;
+    extern template struct GDBusProperty<TYPE_VDICT, dict_t>;
+    extern template struct GDBusProperty<TYPE_VDICT, vdict_t>;
+
 }
 
 
@@ -18,141 +18,144 @@
  */
 
 #include <gio/gio.h>
+#include <gio/gunixfdlist.h>
 #include <string>
 #include <map>
+#include <vector>
 #include <mutex>
 #include <utility>
 #include <algorithm>
+#include <cstring>
 #include "GDBusClient.hpp"
 
 #include <iostream>
 
-namespace {
+namespace gdbus_client {
 
-    struct variant_t {
-        GVariant *gv = nullptr;
+// GDBusVariantAccess gives the converters access to the GVariant held by GDBusVariant.
+struct GDBusVariantAccess {
+    static GVariant * get(const GDBusVariant &v) { return static_cast<GVariant*>(v.gv); }
 
-        operator bool() { return gv != nullptr; }
+    // Make a GDBusVariant holding the reference to gv, which is released in its dtor
+    static GDBusVariant adopt(GVariant *gv) {
+        GDBusVariant v;
+        v.gv = gv;
+        return v;
+    }
+};
 
-        variant_t(GVariant *g) : gv{g} {}
 
-        variant_t() = default;
 
-        variant_t(const variant_t &v) : gv{v.gv} {
-            if (gv) {
-                g_variant_ref(gv);
-            }
-        }
-        variant_t(variant_t && v) noexcept {
-            unref();
-            std::swap(gv, v.gv);
-        }
-        ~variant_t() { unref(); }
-        void unref() {
-            if (gv)  {
-                g_variant_unref(gv);
-            }
-            gv = nullptr;
-        }
-    };
-
-    struct variants_map_t {
-        using key_t = const gdbus_client::GDBusVariant*;
+GDBusVariant::GDBusVariant() noexcept : gv{nullptr} {}
 
-        std::map<key_t, variant_t> variants;
-        std::mutex mutex;
-
-        void insert(key_t key, variant_t &&v) {
-            std::lock_guard<std::mutex> lock{ mutex };
-            variants.emplace(key, std::move(v));
-        }
+GDBusVariant::~GDBusVariant()  {
+    if (gv)
+        g_variant_unref(static_cast<GVariant*>(gv));
+}
 
-        variant_t at(key_t key) {
-            std::lock_guard<std::mutex> lock{ mutex };
-            return variants.count(key)? variants.at(key) : variant_t{};
-        }
+GDBusVariant::GDBusVariant(const GDBusVariant &v) : gv{v.gv} {
+    if (gv)
+        g_variant_ref(static_cast<GVariant*>(gv));
+}
 
-        void erase(const key_t &key) {
-            std::lock_guard<std::mutex> lock{ mutex };
-            variants.erase(key);
-        }
-    }
-    variants;
+GDBusVariant::GDBusVariant(GDBusVariant &&v) noexcept : gv{v.gv} {
+    v.gv = nullptr;
+}
 
+GDBusVariant& GDBusVariant::operator=(const GDBusVariant &v) {
+    GDBusVariant copy{v};
+    std::swap(gv, copy.gv);
+    return *this;
 }
 
-namespace gdbus_client {
+GDBusVariant& GDBusVariant::operator=(GDBusVariant &&v) noexcept {
+    std::swap(gv, v.gv);
+    return *this;
+}
 
 
-GDBusVariant::GDBusVariant()  {
-//    variants.insert(this, variant_t{});
-}
-GDBusVariant::~GDBusVariant()  {
-    variants.erase(this);
-}
-GDBusVariant::GDBusVariant(const GDBusVariant &v) {
-    variants.insert(this, variants.at(&v));
-}
+GDBusVariant::GDBusVariant(int32_t i)             : gv{g_variant_ref_sink(g_variant_new_int32(i))} {}
+GDBusVariant::GDBusVariant(uint32_t u)            : gv{g_variant_ref_sink(g_variant_new_uint32(u))} {}
+GDBusVariant::GDBusVariant(int64_t x)             : gv{g_variant_ref_sink(g_variant_new_int64(x))} {}
+GDBusVariant::GDBusVariant(uint64_t t)            : gv{g_variant_ref_sink(g_variant_new_uint64(t))} {}
+GDBusVariant::GDBusVariant(bool b)                : gv{g_variant_ref_sink(g_variant_new_boolean(b))} {}
+GDBusVariant::GDBusVariant(double d)              : gv{g_variant_ref_sink(g_variant_new_double(d))} {}
+GDBusVariant::GDBusVariant(const char *s)         : gv{g_variant_ref_sink(g_variant_new_string(s ? s : ""))} {}
+GDBusVariant::GDBusVariant(const std::string &s)  : gv{g_variant_ref_sink(g_variant_new_string(s.c_str()))} {}
 
-GDBusVariant& GDBusVariant::operator=(const GDBusVariant &v) {
-    variants.erase(this);
-    variants.insert(this, variants.at(&v));
-    return *this;
+const char* GDBusVariant::type() const {
+    GVariant *v = GDBusVariantAccess::get(*this);
+    return v ? g_variant_get_type_string(v) : "";
 }
 
 
 int GDBusVariant::getInt(bool &result) const {
     int ret = 0;
-    result = false;
-    if (variant_t v = variants.at(this)) {
-        if (g_variant_is_of_type(v.gv, G_VARIANT_TYPE_INT32)) {
-            ret = g_variant_get_int32(v.gv);
-            result = true;
-        }
-    }
+    GVariant *v = GDBusVariantAccess::get(*this);
+    result = v && g_variant_is_of_type(v, G_VARIANT_TYPE_INT32);
+    if (result)
+        ret = g_variant_get_int32(v);
     return ret;
 }
 
 bool GDBusVariant::getBool(bool &result) const {
     bool ret = false;
-    result = false;
-    if (variant_t v = variants.at(this)) {
-        if (g_variant_is_of_type(v.gv, G_VARIANT_TYPE_BOOLEAN)) {
-            ret = (g_variant_get_boolean(v.gv) != 0);
-            result = true;
-        }
-    }
+    GVariant *v = GDBusVariantAccess::get(*this);
+    result = v && g_variant_is_of_type(v, G_VARIANT_TYPE_BOOLEAN);
+    if (result)
+        ret = (g_variant_get_boolean(v) != 0);
     return ret;
 }
 
 double GDBusVariant::getDouble(bool &result) const {
     double ret = 0.0;
-    result = false;
-    if (variant_t v = variants.at(this)) {
-        if (g_variant_is_of_type(v.gv, G_VARIANT_TYPE_DOUBLE)) {
-            ret = g_variant_get_double(v.gv);
-            result = true;
-        }
-    }
+    GVariant *v = GDBusVariantAccess::get(*this);
+    result = v && g_variant_is_of_type(v, G_VARIANT_TYPE_DOUBLE);
+    if (result)
+        ret = g_variant_get_double(v);
     return ret;
 }
 
 std::string GDBusVariant::getString(bool &result) const {
     std::string ret;
-    result = false;
-    if (variant_t v = variants.at(this)) {
-        if (g_variant_is_of_type(v.gv, G_VARIANT_TYPE_STRING)) {
-            ret = g_variant_get_string(v.gv, nullptr);
-            result = true;
-        }
-    }
+    GVariant *v = GDBusVariantAccess::get(*this);
+    result = v && g_variant_is_of_type(v, G_VARIANT_TYPE_STRING);
+    if (result)
+        ret = g_variant_get_string(v, nullptr);
+    return ret;
+}
+
+uint32_t GDBusVariant::getUint(bool &result) const {
+    uint32_t ret = 0;
+    GVariant *v = GDBusVariantAccess::get(*this);
+    result = v && g_variant_is_of_type(v, G_VARIANT_TYPE_UINT32);
+    if (result)
+        ret = g_variant_get_uint32(v);
+    return ret;
+}
+
+int64_t GDBusVariant::getInt64(bool &result) const {
+    int64_t ret = 0;
+    GVariant *v = GDBusVariantAccess::get(*this);
+    result = v && g_variant_is_of_type(v, G_VARIANT_TYPE_INT64);
+    if (result)
+        ret = g_variant_get_int64(v);
+    return ret;
+}
+
+uint64_t GDBusVariant::getUint64(bool &result) const {
+    uint64_t ret = 0;
+    GVariant *v = GDBusVariantAccess::get(*this);
+    result = v && g_variant_is_of_type(v, G_VARIANT_TYPE_UINT64);
+    if (result)
+        ret = g_variant_get_uint64(v);
     return ret;
 }
 
 std::string GDBusVariant::print() const {
     std::string ret;
-    if (variant_t v = variants.at(this)) {
-        char *s = g_variant_print(v.gv, false);
+    if (GVariant *v = GDBusVariantAccess::get(*this)) {
+        char *s = g_variant_print(v, false);
         ret = s;
         g_free(s);
     }
@@ -165,82 +168,21 @@ std::string GDBusVariant::print() const {
 namespace {
     using gdbus_client::GDBusTuple;
     using gdbus_client::GDBusVariant;
-    using getter_t = std::string(*)(const GDBusVariant&, bool&);
-    using handle_t = const void*;
-
-    struct field_ptr { const GDBusTuple * pt; getter_t getter; };
-    std::map<handle_t, field_ptr> fields;
-    bool unusedResult;
-
-
-    struct tuple_t {
-        std::vector<GDBusVariant> vars;
-        std::vector<getter_t> getters;
-        std::vector<handle_t > handles;
-
-        tuple_t() = default;
-
-        tuple_t(const tuple_t &t) {
-            vars = t.vars;
-        }
-
-        unsigned newField(handle_t fh, getter_t getter) {
-            handles.push_back(fh);
-            getters.push_back(getter);
-            return static_cast<unsigned >(getters.size() - 1);
-        }
-
-        GDBusVariant getVarByHandle(handle_t &fh) {
-            const auto i = std::find(handles.begin(), handles.end(), fh);
-            const auto pos = std::distance(handles.begin(), i);
-            return pos >= 0 && pos < vars.size()? vars[pos] : GDBusVariant{};
-        }
-
-        std::string toString() const {
-            if (vars.size() != getters.size()) {
-                return "";
-            }
-            std::string str;
-            for (unsigned i = 0; i < vars.size(); i++) {
-                bool res = false;
-                str += (str.empty() ? "" : " ");
-                str += "<" + getters[i](vars[i], res) + ">";
-                if (!res) {
-                    return std::string();
-                }
-            }
-            return std::string("(") + str + ")";
-        }
-
-        bool assign(const std::vector<GDBusVariant> &variants) {
-            vars = variants;
-            return !toString().empty();
-        }
-    };
 
+    // The tuple being constructed in this thread: its fields, constructed after it, are bound to it.
     thread_local GDBusTuple *curTuple = nullptr;
-    std::map<const GDBusTuple*, tuple_t> tuples;
-
-    std::string strInt(   const GDBusVariant &v, bool &res) { return std::to_string(v.getInt(res));     }
-    std::string strDouble(const GDBusVariant &v, bool &res) { return std::to_string(v.getDouble(res));  }
-    std::string strBool(  const GDBusVariant &v, bool &res) { return std::to_string(v.getBool(res));    }
-    std::string strString(const GDBusVariant &v, bool &res) { return v.getString(res);                  }
-
-
-
-    void addField(handle_t fh, const GDBusTuple* ptuple, getter_t getter) {
-        fields[fh] = field_ptr{ ptuple, getter };
-        tuples[ptuple].newField(fh, getter);
-    }
-
-    void delField(handle_t fh) { fields.erase(fh); }
 
-    GDBusVariant getField(handle_t fh) {
-        if (!fields.count(fh) || !tuples.count(fields[fh].pt)) {
-            return GDBusVariant{};
+    // Checks that v has the D-Bus type of the field, and optionally prints it
+    bool checkField(char type, const GDBusVariant &v, std::string *str) {
+        bool res = false;
+        switch (type) {
+            case 'i': { const int x    = v.getInt(res);    if (res && str) *str = std::to_string(x); break; }
+            case 'd': { const double x = v.getDouble(res); if (res && str) *str = std::to_string(x); break; }
+            case 'b': { const bool x   = v.getBool(res);   if (res && str) *str = std::to_string(x); break; }
+            case 's': { std::string x  = v.getString(res); if (res && str) *str = std::move(x);      break; }
+            default:  break;
         }
-        tuple_t & tuple = tuples[fields[fh].pt];
-        return tuple.getVarByHandle(fh);
+        return res;
     }
 }
 
@@ -248,46 +190,74 @@ namespace gdbus_client {
 
 GDBusTuple::GDBusTuple() {
     curTuple = this;
-    tuples.erase(this);
 }
 
 GDBusTuple::~GDBusTuple() {
-    tuples.erase(this);
-    curTuple = nullptr;
+    if (curTuple == this)
+        curTuple = nullptr;
 }
 
-GDBusTuple::GDBusTuple(const GDBusTuple &tuple) noexcept {
-    curTuple = this;
-    tuples.erase(this);
-    tuples.emplace(this, tuples[&tuple]);
+GDBusTuple::GDBusTuple(const GDBusTuple &tuple) noexcept : vars{tuple.vars} {
+    curTuple = this;    // the copied fields bind to this instance, see field::field(const field&)
 }
 
 GDBusTuple& GDBusTuple::operator=(const GDBusTuple &tuple) {
     curTuple = nullptr;
-    tuples[this].assign(tuples[&tuple].vars);
+    vars = tuple.vars;
     return *this;
 }
+
 bool GDBusTuple::assign(const std::vector<GDBusVariant> &variants) {
-    return tuples[this].assign(variants);
+    vars = variants;
+    if (vars.size() != types.size())
+        return false;
+    for (unsigned i = 0; i < vars.size(); i++) {
+        if (!checkField(types[i], vars[i], nullptr))
+            return false;
+    }
+    return true;
 }
+
 std::string GDBusTuple::toString() const {
-    return tuples[this].toString();
+    if (vars.size() != types.size()) {
+        return "";
+    }
+    std::string str, field;
+    for (unsigned i = 0; i < vars.size(); i++) {
+        if (!checkField(types[i], vars[i], &field)) {
+            return std::string();
+        }
+        str += (str.empty() ? "<" : " <") + field + ">";
+    }
+    return std::string("(") + str + ")";
+}
+
+GDBusTuple::field::field(char type) : tuple{curTuple}, index{0} {
+    if (curTuple) {
+        index = static_cast<unsigned>(curTuple->types.size());
+        curTuple->types.push_back(type);
+    }
 }
+GDBusTuple::field::field(const GDBusTuple::field &f)
+    : field(f.tuple && f.index < f.tuple->types.size() ? f.tuple->types[f.index] : '\0')
+{}
+GDBusTuple::field::~field() {}
+GDBusTuple::field& GDBusTuple::field::operator=(const GDBusTuple::field &) { return *this; }
 
-GDBusTuple::field::field() {}
-GDBusTuple::field::~field() { delField(this); }
-GDBusTuple::field::field(const GDBusTuple::field &f) {
-    addField(this, curTuple, fields[&f].getter);
+const GDBusVariant& GDBusTuple::field::value() const {
+    static const GDBusVariant none;
+    return tuple && index < tuple->vars.size() ? tuple->vars[index] : none;
 }
-GDBusTuple::pint    ::pint()    { addField(this, curTuple, &strInt);    }
-GDBusTuple::pdouble ::pdouble() { addField(this, curTuple, &strDouble); }
-GDBusTuple::pbool   ::pbool()   { addField(this, curTuple, &strBool);   }
-GDBusTuple::pstring ::pstring() { addField(this, curTuple, &strString); }
 
-GDBusTuple::pint    ::operator int()        const { return getField(this).getInt(unusedResult);    }
-GDBusTuple::pdouble ::operator double()     const { return getField(this).getDouble(unusedResult); }
-GDBusTuple::pbool   ::operator bool()       const { return getField(this).getBool(unusedResult);   }
-GDBusTuple::pstring ::operator std::string()const { return getField(this).getString(unusedResult); }
+GDBusTuple::pint    ::pint()    : field('i') {}
+GDBusTuple::pdouble ::pdouble() : field('d') {}
+GDBusTuple::pbool   ::pbool()   : field('b') {}
+GDBusTuple::pstring ::pstring() : field('s') {}
+
+GDBusTuple::pint    ::operator int()        const { bool res; return value().getInt(res);    }
+GDBusTuple::pdouble ::operator double()     const { bool res; return value().getDouble(res); }
+GDBusTuple::pbool   ::operator bool()       const { bool res; return value().getBool(res);   }
+GDBusTuple::pstring ::operator std::string()const { bool res; return value().getString(res); }
 
 
 
@@ -373,7 +343,7 @@ GVariant * marshal(const TYPE_D, const double x) {
 
 bool unmarshal(const TYPE_D, GVariant *gv, double &x) {
     return  g_variant_is_of_type(gv, G_VARIANT_TYPE_DOUBLE) ?
-            (x =  static_cast<bool>(g_variant_get_double(gv))), true:
+            (x = g_variant_get_double(gv)), true:
             false;
 }
 
@@ -389,6 +359,35 @@ bool unmarshal(const TYPE_O, GVariant *gv, std::string &path) {
                 false;
 }
 
+GUnixFDList*& outFdList() {
+    thread_local GUnixFDList *fds = nullptr;
+    return fds;
+}
+
+GUnixFDList*& inFdList() {
+    thread_local GUnixFDList *fds = nullptr;
+    return fds;
+}
+
+GVariant * marshal(const TYPE_H, const int fd) {    // The fd is duplicated into the fd list of the message
+    GUnixFDList *&fds = outFdList();
+    if (!fds)
+        fds = g_unix_fd_list_new();
+    const int index = fd >= 0 ? g_unix_fd_list_append(fds, fd, nullptr) : -1;
+    return index >= 0 ? g_variant_new_handle(index) : nullptr;
+}
+
+bool unmarshal(const TYPE_H, GVariant *gv, int &fd) {   // The fd returned is a duplicate owned by the caller
+    GUnixFDList *fds = inFdList();
+    if (!fds || !g_variant_is_of_type(gv, G_VARIANT_TYPE_HANDLE))
+        return false;
+    const int received = g_unix_fd_list_get(fds, g_variant_get_handle(gv), nullptr);
+    if (received < 0)
+        return false;
+    fd = received;
+    return true;
+}
+
 GVariant * marshal(const TYPE_V, const std::string &v) {
     return g_variant_new_variant(g_variant_new_string(v.c_str()));
 }
@@ -418,18 +417,93 @@ GVariant * marshal(const TYPE_AS, const str_arr_t &arr) {
     return g_variant_builder_end(build);
 }
 
+// The unmarshallers of the containers reuse the existing elements of the output
+// value: the strings are assigned in place, keeping their capacity, and the nodes of
+// the map entries with the same keys are kept. Thus, when the same GDBusCall instance
+// is called repeatedly with similar replies, decoding does not allocate.
+bool unmarshalStrArr(GVariant *g, const char *format, str_arr_t &arr) {
+    if ( !g_variant_type_is_array(g_variant_get_type(g)) ) {
+        arr.clear();
+        return false;
+    }
+
+    GVariantIter i;
+    arr.resize(g_variant_iter_init (&i, g));
+    auto elem = arr.begin();
+    for (const gchar *s; elem != arr.end() && g_variant_iter_next(&i, format, &s); ++elem)
+        elem->assign(s);
+    arr.erase(elem, arr.end());     // in case the iteration stopped early
+    return true;
+}
+
+// dict_assigner_t assigns the entries of a reply to a map, reusing the entries with
+// the same keys, and then erases the entries with the keys absent from the reply.
+template<typename Map>
+struct dict_assigner_t {
+    Map &map;
+    std::string &key;                                       // a scratch buffer for the lookup
+    std::vector<const typename Map::value_type*> &seen;     // the entries assigned from the reply
+
+    explicit dict_assigner_t(Map &map) : map(map), key(keyBuffer()), seen(seenBuffer()) {
+        seen.clear();
+    }
+
+    // The value of the entry with the given key, to be assigned
+    typename Map::mapped_type& operator[](const char *k) {
+        key.assign(k);
+        auto it = map.find(key);
+        if (it == map.end())
+            it = map.emplace(key, typename Map::mapped_type()).first;
+        seen.push_back(&*it);
+        return it->second;
+    }
+
+    ~dict_assigner_t() {
+        std::sort(seen.begin(), seen.end());        // The reply may contain duplicate keys,
+        seen.erase(std::unique(seen.begin(), seen.end()), seen.end());  // so only count the distinct ones
+        if (seen.size() == map.size())
+            return;
+        for (auto it = map.begin(); it != map.end();) {
+            if (std::binary_search(seen.begin(), seen.end(), &*it))
+                ++it;
+            else
+                it = map.erase(it);
+        }
+    }
+
+private:
+    static std::string& keyBuffer() { thread_local std::string key; return key; }
+    static std::vector<const typename Map::value_type*>& seenBuffer() {
+        thread_local std::vector<const typename Map::value_type*> seen;
+        return seen;
+    }
+};
+
 bool unmarshal(const TYPE_AS, GVariant *g, str_arr_t &arr) {
-    arr.clear();
-    if ( !g_variant_type_is_array(g_variant_get_type(g)) )
+    return unmarshalStrArr(g, "&s", arr);
+}
+
+// The views refer to the strings inside the serialized reply ('&s' and '&o' formats),
+// so the only allocation is the growth of the items vector.
+template<typename View>
+bool unmarshalStrView(GVariant *g, const char *type, const char *format, View &view) {
+    view.items.clear();
+    view.reply = GDBusVariant{};
+    if ( !g_variant_is_of_type(g, G_VARIANT_TYPE(type)) )   // the exact type: the format must match it
         return false;
 
+    view.reply = GDBusVariantAccess::adopt(g_variant_ref(g));
     GVariantIter i;
-    g_variant_iter_init (&i, g);
-    for (gchar *s; g_variant_iter_loop(&i, "s", &s);)
-        arr.push_back(s);
+    view.items.reserve(g_variant_iter_init (&i, g));
+    for (const gchar *s; g_variant_iter_next(&i, format, &s);)
+        view.items.push_back(s);
     return true;
 }
 
+bool unmarshal(const TYPE_AS, GVariant *g, as_view_t &view) {
+    return unmarshalStrView(g, "as", "&s", view);
+}
+
 GVariant * marshal(const TYPE_AO, const str_arr_t &arr) {
     GVariantBuilder *build = g_variant_builder_new(G_VARIANT_TYPE("ao"));
     for (const std::string &s: arr)
@@ -438,17 +512,43 @@ GVariant * marshal(const TYPE_AO, const str_arr_t &arr) {
 }
 
 bool unmarshal(const TYPE_AO, GVariant *g, str_arr_t &arr) {
-    arr.clear();
-    if ( !g_variant_type_is_array(g_variant_get_type(g)) )
-        return false;
+    return unmarshalStrArr(g, "&o", arr);
+}
 
-    GVariantIter i;
-    g_variant_iter_init (&i, g);
-    for (gchar *s; g_variant_iter_loop(&i, "o", &s);)
-        arr.push_back(s);
+// The arrays of fixed-width numbers are serialized in the native layout, so they are
+// encoded and decoded as a whole, with a single copy.
+template<typename T>
+GVariant * marshalFixedArr(const char *type, const std::vector<T> &arr) {
+    return g_variant_new_fixed_array(G_VARIANT_TYPE(type + 1),     // the element type
+                                     arr.data(), arr.size(), sizeof(T));
+}
+
+template<typename T>
+bool unmarshalFixedArr(GVariant *g, const char *type, std::vector<T> &arr) {
+    if ( !g_variant_is_of_type(g, G_VARIANT_TYPE(type)) ) {
+        arr.clear();
+        return false;
+    }
+    gsize n = 0;
+    const void *elems = g_variant_get_fixed_array(g, &n, sizeof(T));
+    arr.resize(n);
+    if (n)
+        std::memcpy(arr.data(), elems, n * sizeof(T));
     return true;
 }
 
+GVariant * marshal(const TYPE_AY, const byte_arr_t &arr)            { return marshalFixedArr("ay", arr); }
+GVariant * marshal(const TYPE_AI, const int_arr_t &arr)             { return marshalFixedArr("ai", arr); }
+GVariant * marshal(const TYPE_AU, const uint_arr_t &arr)            { return marshalFixedArr("au", arr); }
+GVariant * marshal(const TYPE_AT, const uint64_arr_t &arr)          { return marshalFixedArr("at", arr); }
+GVariant * marshal(const TYPE_AD, const double_arr_t &arr)          { return marshalFixedArr("ad", arr); }
+
+bool unmarshal(const TYPE_AY, GVariant *g, byte_arr_t &arr)         { return unmarshalFixedArr(g, "ay", arr); }
+bool unmarshal(const TYPE_AI, GVariant *g, int_arr_t &arr)          { return unmarshalFixedArr(g, "ai", arr); }
+bool unmarshal(const TYPE_AU, GVariant *g, uint_arr_t &arr)         { return unmarshalFixedArr(g, "au", arr); }
+bool unmarshal(const TYPE_AT, GVariant *g, uint64_arr_t &arr)       { return unmarshalFixedArr(g, "at", arr); }
+bool unmarshal(const TYPE_AD, GVariant *g, double_arr_t &arr)       { return unmarshalFixedArr(g, "ad", arr); }
+
 GVariant * marshal(const TYPE_DICT, const std::map<string, string> &items) {
     GVariantBuilder *build = g_variant_builder_new(G_VARIANT_TYPE("a{ss}"));
     for (const auto &e: items)
@@ -459,34 +559,175 @@ GVariant * marshal(const TYPE_DICT, const std::map<string, string> &items) {
 }
 
 bool unmarshal(const TYPE_DICT, GVariant *g, dict_t &map) {
-    map.clear();
-    if ( !g_variant_type_is_array(g_variant_get_type(g)) )
+    if ( !g_variant_type_is_array(g_variant_get_type(g)) ) {
+        map.clear();
         return false;
+    }
 
     GVariantIter i;
     g_variant_iter_init (&i, g);
-    for (gchar *k, *v; g_variant_iter_loop(&i, "{ss}", &k, &v);)
-        map[k] = v;
+    dict_assigner_t<dict_t> entries{ map };
+    for (const gchar *k, *v; g_variant_iter_next(&i, "{&s&s}", &k, &v);)
+        entries[k].assign(v);
 
     return true;
 }
 
-/* GVariant * marshal(const TYPE_VDICT, const std::map<string, string> &items) {// Not implemented: not needed.
-    return nullptr;
+bool unmarshal(const TYPE_AO, GVariant *g, ao_view_t &view) {
+    return unmarshalStrView(g, "ao", "&o", view);
+}
+
+bool unmarshal(const TYPE_DICT, GVariant *g, dict_view_t &view) {
+    view.items.clear();
+    view.reply = GDBusVariant{};
+    if ( !g_variant_is_of_type(g, G_VARIANT_TYPE("a{ss}")) )
+        return false;
+
+    view.reply = GDBusVariantAccess::adopt(g_variant_ref(g));
+    GVariantIter i;
+    view.items.reserve(g_variant_iter_init (&i, g));
+    for (const gchar *k, *v; g_variant_iter_next(&i, "{&s&s}", &k, &v);)
+        view.items.emplace_back(k, v);
+    return true;
+}
+
+/* GVariant * marshal(const TYPE_VDICT, const std::map<string, string> &items) {// Not implemented: the printed values
+    return nullptr;                                                             //      cannot be parsed back; see vdict_t
 } */
 
 bool unmarshal(const TYPE_VDICT, GVariant *g, dict_t &map) {
-    map.clear();
-    if ( !g_variant_type_is_array(g_variant_get_type(g)) )
+    if ( !g_variant_type_is_array(g_variant_get_type(g)) ) {
+        map.clear();
         return false;
+    }
 
     GVariantIter i;
     GVariant *v;
     g_variant_iter_init (&i, g);
-    for (gchar *k; g_variant_iter_loop(&i, "{sv}", &k, &v);) {
+    dict_assigner_t<dict_t> entries{ map };
+    for (const gchar *k; g_variant_iter_next(&i, "{&sv}", &k, &v);) {
         gchar *s = g_variant_print(v, false);
-        map[k] = (s ?: "<NULL>");
+        entries[k].assign(s ?: "<NULL>");
         g_free(s);
+        g_variant_unref(v);
+    }
+    return true;
+}
+
+// The values of vdict_t are kept as they are, so neither encoding nor decoding
+// goes through the text form of the values.
+GVariant * marshal(const TYPE_VDICT, const vdict_t &items) {
+    GVariantBuilder *build = g_variant_builder_new(G_VARIANT_TYPE("a{sv}"));
+    for (const auto &e: items) {
+        GVariant *value = GDBusVariantAccess::get(e.second);
+        if (!value) {                                   // an empty GDBusVariant cannot be sent
+            g_variant_builder_unref(build);
+            return nullptr;
+        }
+        g_variant_builder_add_value(build, g_variant_new_dict_entry(g_variant_new_string(e.first.c_str()),
+                                                                    g_variant_new_variant(value)));
+    }
+    GVariant *res = g_variant_builder_end(build);
+    g_variant_builder_unref(build);
+    return res;
+}
+
+bool unmarshal(const TYPE_VDICT, GVariant *g, vdict_t &map) {
+    if ( !g_variant_is_of_type(g, G_VARIANT_TYPE("a{sv}")) ) {
+        map.clear();
+        return false;
+    }
+
+    GVariantIter i;
+    GVariant *v;
+    g_variant_iter_init (&i, g);
+    dict_assigner_t<vdict_t> entries{ map };
+    for (const gchar *k; g_variant_iter_next(&i, "{&sv}", &k, &v);)
+        entries[k] = GDBusVariantAccess::adopt(v);     // the reference returned by the iterator is adopted
+    return true;
+}
+
+// The mapped structs (GDBUS_STRUCT) are encoded and decoded field by field, following
+// the layout. The type of the whole param is checked once, so the fields are not checked.
+GVariant * marshalRow(const GDBusStructLayout &l, const void *row) {
+    GVariantBuilder *build = g_variant_builder_new(G_VARIANT_TYPE(l.signature.c_str()));
+    for (const GDBusStructLayout::field_t &f: l.fields) {
+        const void *p = f.get(const_cast<void*>(row));
+        GVariant *v = nullptr;
+        switch (f.type) {
+            case 's': v = g_variant_new_string(static_cast<const std::string*>(p)->c_str()); break;
+            case 'i': v = g_variant_new_int32(*static_cast<const int32_t*>(p));     break;
+            case 'u': v = g_variant_new_uint32(*static_cast<const uint32_t*>(p));   break;
+            case 'n': v = g_variant_new_int16(*static_cast<const int16_t*>(p));     break;
+            case 'q': v = g_variant_new_uint16(*static_cast<const uint16_t*>(p));   break;
+            case 'y': v = g_variant_new_byte(*static_cast<const uint8_t*>(p));      break;
+            case 'x': v = g_variant_new_int64(*static_cast<const int64_t*>(p));     break;
+            case 't': v = g_variant_new_uint64(*static_cast<const uint64_t*>(p));   break;
+            case 'd': v = g_variant_new_double(*static_cast<const double*>(p));     break;
+            case 'b': v = g_variant_new_boolean(*static_cast<const bool*>(p));      break;
+            case '(': v = marshalRow(*f.nested, p);                                 break;
+        }
+        g_variant_builder_add_value(build, v);
+    }
+    GVariant *ret = g_variant_builder_end(build);
+    g_variant_builder_unref(build);
+    return ret;
+}
+
+void unmarshalRow(const GDBusStructLayout &l, GVariant *g, void *row) {
+    GVariantIter i;
+    g_variant_iter_init(&i, g);
+    for (const GDBusStructLayout::field_t &f: l.fields) {
+        GVariant *v = g_variant_iter_next_value(&i);
+        void *p = f.get(row);
+        switch (f.type) {
+            case 's': static_cast<std::string*>(p)->assign(g_variant_get_string(v, nullptr)); break;
+            case 'i': *static_cast<int32_t*>(p)  = g_variant_get_int32(v);          break;
+            case 'u': *static_cast<uint32_t*>(p) = g_variant_get_uint32(v);         break;
+            case 'n': *static_cast<int16_t*>(p)  = g_variant_get_int16(v);          break;
+            case 'q': *static_cast<uint16_t*>(p) = g_variant_get_uint16(v);         break;
+            case 'y': *static_cast<uint8_t*>(p)  = g_variant_get_byte(v);           break;
+            case 'x': *static_cast<int64_t*>(p)  = g_variant_get_int64(v);          break;
+            case 't': *static_cast<uint64_t*>(p) = g_variant_get_uint64(v);         break;
+            case 'd': *static_cast<double*>(p)   = g_variant_get_double(v);         break;
+            case 'b': *static_cast<bool*>(p)     = g_variant_get_boolean(v);        break;
+            case '(': unmarshalRow(*f.nested, v, p);                                break;
+        }
+        g_variant_unref(v);
+    }
+}
+
+GVariant * marshal(const GDBusStructParam &par) {
+    const GDBusStructLayout &l = par.layout;
+    const void *value = par.value(const_cast<GDBusStructParam*>(&par));
+    if (!par.array)
+        return marshalRow(l, value);
+
+    GVariantBuilder *build = g_variant_builder_new(G_VARIANT_TYPE(l.array_signature.c_str()));
+    const char *rows = static_cast<const char*>(l.data(value));
+    for (size_t n = l.size(value), r = 0; r < n; r++)
+        g_variant_builder_add_value(build, marshalRow(l, rows + r * l.row_size));
+    GVariant *ret = g_variant_builder_end(build);
+    g_variant_builder_unref(build);
+    return ret;
+}
+
+bool unmarshal(GDBusStructParam &par, GVariant *g) {
+    const GDBusStructLayout &l = par.layout;
+    void *value = par.value(&par);
+    const std::string &type = par.array ? l.array_signature : l.signature;
+    if ( !g_variant_is_of_type(g, G_VARIANT_TYPE(type.c_str())) )
+        return false;
+    if (!par.array) {
+        unmarshalRow(l, g, value);
+        return true;
+    }
+
+    GVariantIter i;
+    char *rows = static_cast<char*>(l.resize(value, g_variant_iter_init(&i, g)));   // the existing rows are reused
+    for (GVariant *row; (row = g_variant_iter_next_value(&i)); rows += l.row_size) {
+        unmarshalRow(l, row, rows);
+        g_variant_unref(row);
     }
     return true;
 }
@@ -496,25 +737,27 @@ bool unmarshal(const TYPE_VDICT, GVariant *g, dict_t &map) {
 } */                                                                //      and does not map to any specific Dbus type.
 
 bool unmarshal(const TYPE_ATUP, GVariant *g, tuple_arr_t &arr) {
-    arr.clear();
     if ( !g_variant_type_is_array(g_variant_get_type(g)) ) {
+        arr.clear();
         return false;
     }
 
     GVariantIter i;
-    g_variant_iter_init (&i, g);
+    arr.resize(g_variant_iter_init (&i, g));    // Reuse the inner vectors and their capacity
+    auto elem = arr.begin();
     for (GVariant *tuple; (tuple = g_variant_iter_next_value(&i));) {
         if (g_variant_is_container(tuple)) {
-            arr.emplace_back();
+            std::vector<GDBusVariant> &fields = *elem++;
+            fields.clear();
             GVariantIter j;
-            g_variant_iter_init (&j, tuple);
+            fields.reserve(g_variant_iter_init (&j, tuple));
             for (GVariant *field; (field = g_variant_iter_next_value(&j));) {
-                arr.back().emplace_back();
-                variants.insert(&arr.back().back(), variant_t{field});   //field is to be unreferenced in dtor of this variant_t
+                fields.emplace_back(GDBusVariantAccess::adopt(field));   //field is unreferenced in dtor of the GDBusVariant
             }
         }
         g_variant_unref(tuple);
     }
+    arr.erase(elem, arr.end());                 // Drop the slots of skipped non-container elements
     return true;
 }
 